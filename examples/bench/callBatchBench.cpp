@@ -0,0 +1,84 @@
+/*==========================================================
+ * callBatchBench.cpp - benchmark of batched MATLAB calls
+ *
+ * Calls a MATLAB function on each element of a real double
+ * array, once with a separate feval per element and once
+ * with a single mex::callBatch over all elements.
+ *
+ * The calling syntax is:
+ *
+ *		times = callBatchBench(fn, x)
+ *
+ * where fn is a function handle or function name taking a
+ * scalar double, x is a real double array and times is a
+ * 1x2 vector of elapsed seconds for [feval per element,
+ * callBatch].
+ *
+ *========================================================*/
+
+#include <vector>
+
+#include <matlabw/mex/mex.hpp>
+#include <matlabw/mex/Function.hpp>
+
+#include "measure.hpp"
+
+using namespace matlabw;
+
+void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
+{
+  if (rhs.size() != 2)
+  {
+    throw mx::Exception{"matlabw:callBatchBench:nrhs", "Two inputs required."};
+  }
+
+  if (lhs.size() != 1)
+  {
+    throw mx::Exception{"matlabw:callBatchBench:nlhs", "One output required."};
+  }
+
+  if (!rhs[0].isChar() && !rhs[0].isClass("function_handle"))
+  {
+    throw mx::Exception{"matlabw:callBatchBench:notFunction", "First input must be a function handle or name."};
+  }
+
+  if (!rhs[1].isDouble() || rhs[1].isComplex())
+  {
+    throw mx::Exception{"matlabw:callBatchBench:notRealDouble", "Second input must be a real double array."};
+  }
+
+  const mx::NumericArrayCref<double> x{rhs[1]};
+
+  std::vector<mx::NumericArray<double>> args{};
+  std::vector<mx::ArrayCref>            argRefs{};
+
+  args.reserve(x.getSize());
+  argRefs.reserve(x.getSize());
+
+  for (const double value : x)
+  {
+    argRefs.push_back(args.emplace_back(mx::makeNumericScalar(value)));
+  }
+
+  std::vector<mx::Array> single(x.getSize());
+  std::vector<mx::Array> batched{};
+
+  mx::NumericArray<double> times = mx::makeUninitNumericArray<double>(1, 2);
+
+  times[0] = measure([&]
+  {
+    for (std::size_t i{}; i < argRefs.size(); ++i)
+    {
+      const mx::ArrayCref callRhs[]{rhs[0], argRefs[i]};
+
+      call(mx::Span<mx::Array>{&single[i], 1}, callRhs, "feval");
+    }
+  });
+
+  times[1] = measure([&]
+  {
+    batched = callBatch(rhs[0], argRefs);
+  });
+
+  lhs[0] = std::move(times);
+}
@@ -0,0 +1,90 @@
+/*==========================================================
+ * complexInterleaveBench.cpp - benchmark of the complex
+ * interleave and deinterleave kernels
+ *
+ * Splits a complex double array into real and imaginary
+ * planes and merges them back, using a naive loop and the
+ * mx::deinterleave and mx::interleave kernels.
+ *
+ * The calling syntax is:
+ *
+ *		times = complexInterleaveBench(z)
+ *
+ * where times is a 1x4 vector of elapsed seconds for
+ * [naive deinterleave, naive interleave, mx::deinterleave, mx::interleave].
+ *
+ *========================================================*/
+
+#include <vector>
+
+#include <matlabw/mex/mex.hpp>
+#include <matlabw/mex/Function.hpp>
+
+#include "measure.hpp"
+
+using namespace matlabw;
+
+void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
+{
+  if (rhs.size() != 1)
+  {
+    throw mx::Exception{"matlabw:complexInterleaveBench:nrhs", "One input required."};
+  }
+
+  if (lhs.size() != 1)
+  {
+    throw mx::Exception{"matlabw:complexInterleaveBench:nlhs", "One output required."};
+  }
+
+  if (!rhs[0].isDouble() || !rhs[0].isComplex())
+  {
+    throw mx::Exception{"matlabw:complexInterleaveBench:notComplexDouble", "Input must be a complex double array."};
+  }
+
+  const mx::NumericArrayCref<std::complex<double>> z{rhs[0]};
+
+  const std::size_t n = z.getSize();
+
+  std::vector<double> re(n);
+  std::vector<double> im(n);
+  std::vector<std::complex<double>> out(n);
+
+  mx::NumericArray<double> times = mx::makeUninitNumericArray<double>(1, 4);
+
+  /* the naive loops use raw pointers like the kernels, indexing z would query the data pointer per element */
+  const std::complex<double>* zData = z.getData();
+
+  times[0] = measure([&]
+  {
+    for (std::size_t i{}; i < n; ++i)
+    {
+      re[i] = zData[i].real();
+      im[i] = zData[i].imag();
+    }
+  });
+
+  times[1] = measure([&]
+  {
+    for (std::size_t i{}; i < n; ++i)
+    {
+      out[i] = {re[i], im[i]};
+    }
+  });
+
+  times[2] = measure([&]
+  {
+    mx::deinterleave(z, re, im);
+  });
+
+  times[3] = measure([&]
+  {
+    mx::interleave<double>(re, im, out);
+  });
+
+  if (!std::equal(z.begin(), z.end(), out.begin()))
+  {
+    throw mx::Exception{"matlabw:complexInterleaveBench:mismatch", "Round trip does not reproduce the input."};
+  }
+
+  lhs[0] = std::move(times);
+}
@@ -0,0 +1,81 @@
+/*==========================================================
+ * dispatcherBench.cpp - benchmark of the multi-command MEX
+ * dispatcher
+ *
+ * Routes the first argument, a command name, to one of the
+ * noop, lookup and echo commands through a dispatcher whose
+ * command table is hashed at compile time.
+ *
+ * The calling syntax is:
+ *
+ *		dispatcherBench('noop')
+ *		t = dispatcherBench('lookup', name, n)
+ *		y = dispatcherBench('echo', x)
+ *
+ * where 'noop' does nothing and is timed from MATLAB to
+ * measure the whole call overhead, t is the average time of
+ * n lookups of the command name in nanoseconds and y is a
+ * copy of x.
+ *
+ *========================================================*/
+
+#include <chrono>
+#include <string_view>
+
+#include <matlabw/mex/mex.hpp>
+#include <matlabw/mex/Function.hpp>
+
+using namespace matlabw;
+
+/* dispatcherBench('noop') does nothing, time it from MATLAB to measure the whole call overhead */
+void noop(mex::Function&, mx::Span<mx::Array>, mx::View<mx::ArrayCref>)
+{}
+
+/* t = dispatcherBench('lookup', name, n) measures the average time of n command lookups in nanoseconds */
+void lookup(mex::Function&, mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs);
+
+/* dispatcherBench('echo', x) returns x */
+void echo(mex::Function&, mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
+{
+  if (rhs.size() != 1 || lhs.size() != 1)
+  {
+    throw mx::Exception{"matlabw:dispatcherBench:echo", "One input and one output required."};
+  }
+
+  lhs[0] = mx::Array{rhs[0]};
+}
+
+/* Command table, built at compile time. MATLABW_MEX_DISPATCH defines the same gateway in a single line. */
+constexpr auto dispatcher = mex::makeDispatcher({{"noop", &noop}, {"lookup", &lookup}, {"echo", &echo}});
+
+/* The gateway function */
+void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
+{
+  dispatcher(*this, lhs, rhs);
+}
+
+void lookup(mex::Function&, mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
+{
+  const auto [name, n] = mex::Signature<mex::arg::String, mex::arg::Scalar<double>>::validate(rhs);
+
+  if (lhs.size() != 1)
+  {
+    throw mx::Exception{"matlabw:dispatcherBench:lookup", "One output required."};
+  }
+
+  const std::u16string_view token{name.getData(), name.getSize()};
+  const std::size_t         count = static_cast<std::size_t>(n[0]);
+
+  std::size_t found{};
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (std::size_t i{}; i < count; ++i)
+  {
+    found += (dispatcher.find(token) != nullptr);
+  }
+
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+  lhs[0] = mx::makeNumericScalar((found != 0) ? elapsed.count() / static_cast<double>(count) : 0.0);
+}
@@ -0,0 +1,101 @@
+/*==========================================================
+ * expressionBench.cpp - benchmark of the lazy elementwise
+ * expression templates
+ *
+ * Evaluates a*x + y - c with the scalars x = 2 and c = 0.5,
+ * once with an intermediate array per operation and once
+ * fused into a single pass with mx::expr::evaluate, and
+ * checks that both give the same result.
+ *
+ * The calling syntax is:
+ *
+ *		times = expressionBench(a, y)
+ *
+ * where a and y are real double arrays with the same number
+ * of elements and times is a 1x2 vector of elapsed seconds
+ * for [intermediate arrays, fused expression].
+ *
+ *========================================================*/
+
+#include <algorithm>
+
+#include <matlabw/mex/mex.hpp>
+#include <matlabw/mex/Function.hpp>
+
+#include "measure.hpp"
+
+using namespace matlabw;
+
+void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
+{
+  if (rhs.size() != 2)
+  {
+    throw mx::Exception{"matlabw:expressionBench:nrhs", "Two inputs required."};
+  }
+
+  if (lhs.size() != 1)
+  {
+    throw mx::Exception{"matlabw:expressionBench:nlhs", "One output required."};
+  }
+
+  if (!rhs[0].isDouble() || rhs[0].isComplex() || !rhs[1].isDouble() || rhs[1].isComplex())
+  {
+    throw mx::Exception{"matlabw:expressionBench:notRealDouble", "Inputs must be real double arrays."};
+  }
+
+  const mx::NumericArrayCref<double> a{rhs[0]};
+  const mx::NumericArrayCref<double> y{rhs[1]};
+
+  if (a.getSize() != y.getSize())
+  {
+    throw mx::Exception{"matlabw:expressionBench:sizeMismatch", "Inputs must have the same size."};
+  }
+
+  const double x = 2.0;
+  const double c = 0.5;
+
+  mx::NumericArray<double> naive{};
+  mx::NumericArray<double> fused{};
+
+  mx::NumericArray<double> times = mx::makeUninitNumericArray<double>(1, 2);
+
+  /* a*x + y - c with an intermediate array per operation */
+  times[0] = measure([&]
+  {
+    mx::NumericArray<double> ax = mx::makeUninitNumericArray<double>(a.getDims());
+
+    for (std::size_t i{}; i < a.getSize(); ++i)
+    {
+      ax[i] = a[i] * x;
+    }
+
+    mx::NumericArray<double> axy = mx::makeUninitNumericArray<double>(a.getDims());
+
+    for (std::size_t i{}; i < a.getSize(); ++i)
+    {
+      axy[i] = ax[i] + y[i];
+    }
+
+    naive = mx::makeUninitNumericArray<double>(a.getDims());
+
+    for (std::size_t i{}; i < a.getSize(); ++i)
+    {
+      naive[i] = axy[i] - c;
+    }
+  });
+
+  /* the same expression evaluated in one fused pass */
+  times[1] = measure([&]
+  {
+    using namespace mx::expr;
+
+    fused = evaluate(lazy(a) * x + lazy(y) - c);
+  });
+
+  if (!std::equal(naive.begin(), naive.end(), fused.begin()))
+  {
+    throw mx::Exception{"matlabw:expressionBench:mismatch", "Fused result differs."};
+  }
+
+  lhs[0] = std::move(times);
+}
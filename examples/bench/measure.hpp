@@ -0,0 +1,22 @@
+/*==========================================================
+ * measure.hpp - timing helper shared by the benchmarks
+ *
+ *========================================================*/
+
+#ifndef MATLABW_EXAMPLES_BENCH_MEASURE_HPP
+#define MATLABW_EXAMPLES_BENCH_MEASURE_HPP
+
+#include <chrono>
+
+/* Measures the elapsed time of fn in seconds */
+template<typename Fn>
+double measure(Fn&& fn)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  fn();
+
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+#endif /* MATLABW_EXAMPLES_BENCH_MEASURE_HPP */
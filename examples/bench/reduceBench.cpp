@@ -0,0 +1,106 @@
+/*==========================================================
+ * reduceBench.cpp - benchmark of the sum reduction kernels
+ *
+ * Sums a real double matrix along its columns and rows,
+ * using naive loops and mx::reduce::sum, and checks that
+ * both give the same sums.
+ *
+ * The calling syntax is:
+ *
+ *		times = reduceBench(A)
+ *
+ * where times is a 1x4 vector of elapsed seconds for
+ * [naive column sums, naive row sums, sum(A, 1), sum(A, 2)].
+ *
+ *========================================================*/
+
+#include <cmath>
+#include <vector>
+
+#include <matlabw/mex/mex.hpp>
+#include <matlabw/mex/Function.hpp>
+
+#include "measure.hpp"
+
+using namespace matlabw;
+
+void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
+{
+  if (rhs.size() != 1)
+  {
+    throw mx::Exception{"matlabw:reduceBench:nrhs", "One input required."};
+  }
+
+  if (lhs.size() != 1)
+  {
+    throw mx::Exception{"matlabw:reduceBench:nlhs", "One output required."};
+  }
+
+  if (!rhs[0].isDouble() || rhs[0].isComplex() || rhs[0].getRank() != 2)
+  {
+    throw mx::Exception{"matlabw:reduceBench:notRealDoubleMatrix", "Input must be a real double matrix."};
+  }
+
+  const mx::NumericArrayCref<double> a{rhs[0]};
+
+  const std::size_t m = a.getDimM();
+  const std::size_t n = a.getDimN();
+
+  std::vector<double> columnSums(n);
+  std::vector<double> rowSums(m);
+
+  mx::NumericArray<double> times = mx::makeUninitNumericArray<double>(1, 4);
+
+  times[0] = measure([&]
+  {
+    for (std::size_t j{}; j < n; ++j)
+    {
+      for (std::size_t i{}; i < m; ++i)
+      {
+        columnSums[j] += a[i + j * m];
+      }
+    }
+  });
+
+  times[1] = measure([&]
+  {
+    for (std::size_t i{}; i < m; ++i)
+    {
+      for (std::size_t j{}; j < n; ++j)
+      {
+        rowSums[i] += a[i + j * m];
+      }
+    }
+  });
+
+  mx::NumericArray<double> reducedColumnSums{};
+  mx::NumericArray<double> reducedRowSums{};
+
+  times[2] = measure([&]
+  {
+    reducedColumnSums = mx::reduce::sum(a, 0);
+  });
+
+  times[3] = measure([&]
+  {
+    reducedRowSums = mx::reduce::sum(a, 1);
+  });
+
+  for (std::size_t j{}; j < n; ++j)
+  {
+    if (std::abs(reducedColumnSums[j] - columnSums[j]) > 1e-8 * (1.0 + std::abs(columnSums[j])))
+    {
+      throw mx::Exception{"matlabw:reduceBench:mismatch", "Column sums differ."};
+    }
+  }
+
+  for (std::size_t i{}; i < m; ++i)
+  {
+    if (std::abs(reducedRowSums[i] - rowSums[i]) > 1e-8 * (1.0 + std::abs(rowSums[i])))
+    {
+      throw mx::Exception{"matlabw:reduceBench:mismatch", "Row sums differ."};
+    }
+  }
+
+  lhs[0] = std::move(times);
+}
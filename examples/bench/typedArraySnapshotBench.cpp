@@ -0,0 +1,100 @@
+/*==========================================================
+ * typedArraySnapshotBench.cpp - benchmark of element access
+ * through TypedArrayRef and TypedArraySnapshot
+ *
+ * Sums the elements of a double array using indexed access
+ * and iterators of both TypedArrayRef and TypedArraySnapshot.
+ *
+ * The calling syntax is:
+ *
+ *		times = typedArraySnapshotBench(x)
+ *
+ * where times is a 1x4 vector of elapsed seconds for
+ * [ref indexing, ref iterators, snapshot indexing, snapshot iterators].
+ *
+ *========================================================*/
+
+#include <chrono>
+
+#include <matlabw/mex/mex.hpp>
+#include <matlabw/mex/Function.hpp>
+
+using namespace matlabw;
+
+/* Measures the elapsed time of fn in seconds, stores the result of fn to result */
+template<typename Fn>
+double measure(Fn&& fn, double& result)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  result = fn();
+
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
+{
+  if (rhs.size() != 1)
+  {
+    throw mx::Exception{"matlabw:typedArraySnapshotBench:nrhs", "One input required."};
+  }
+
+  if (lhs.size() != 1)
+  {
+    throw mx::Exception{"matlabw:typedArraySnapshotBench:nlhs", "One output required."};
+  }
+
+  if (!rhs[0].isDouble() || rhs[0].isComplex())
+  {
+    throw mx::Exception{"matlabw:typedArraySnapshotBench:notDouble", "Input must be a real double array."};
+  }
+
+  const mx::NumericArrayCref<double> ref{rhs[0]};
+
+  double results[4]{};
+  mx::NumericArray<double> times = mx::makeUninitNumericArray<double>(1, 4);
+
+  /* each iteration queries the array size and the data pointer */
+  times[0] = measure([&]
+  {
+    double sum{};
+
+    for (std::size_t i{}; i < ref.getSize(); ++i)
+    {
+      sum += ref[i];
+    }
+
+    return sum;
+  }, results[0]);
+
+  times[1] = measure([&]
+  {
+    return std::accumulate(ref.begin(), ref.end(), 0.0);
+  }, results[1]);
+
+  /* the size and the data pointer are read once when the snapshot is created */
+  times[2] = measure([&]
+  {
+    const mx::TypedArraySnapshot snapshot{ref};
+
+    double sum{};
+
+    for (std::size_t i{}; i < snapshot.getSize(); ++i)
+    {
+      sum += snapshot[i];
+    }
+
+    return sum;
+  }, results[2]);
+
+  times[3] = measure([&]
+  {
+    const mx::TypedArraySnapshot snapshot{ref};
+
+    return std::accumulate(snapshot.begin(), snapshot.end(), 0.0);
+  }, results[3]);
+
+  mex::printf("sums: %g %g %g %g\n", results[0], results[1], results[2], results[3]);
+
+  lhs[0] = std::move(times);
+}
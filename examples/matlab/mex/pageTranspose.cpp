@@ -0,0 +1,93 @@
+/*==========================================================
+ * pageTranspose.cpp - example of column-major mdspan views
+ *
+ * Transposes each page of a real double array and returns
+ * the sum of each column of the input, using asMdspan and
+ * the getPage, getRow, getColumn and getBlock helpers.
+ *
+ * The calling syntax is:
+ *
+ *		[outArray, colSums] = pageTranspose(inArray)
+ *
+ * where inArray is M x N x P, outArray is N x M x P and
+ * colSums is 1 x N x P.
+ *
+ *========================================================*/
+
+#include <array>
+#include <matlabw/mex/mex.hpp>
+#include <matlabw/mex/Function.hpp>
+
+using namespace matlabw;
+
+void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
+{
+  if (rhs.size() != 1)
+  {
+    throw mx::Exception{"matlabw:pageTranspose:nrhs", "One input required."};
+  }
+
+  if (lhs.size() > 2)
+  {
+    throw mx::Exception{"matlabw:pageTranspose:nlhs", "Too many output arguments."};
+  }
+
+  if (!rhs[0].isDouble() || rhs[0].isComplex() || rhs[0].isSparse())
+  {
+    throw mx::Exception{"matlabw:pageTranspose:notRealDouble", "Input must be a full real double array."};
+  }
+
+  const mx::NumericArrayCref<double> in{rhs[0]};
+
+  /* trailing dimensions are folded into the pages */
+  const auto src = in.asMdspan<3>();
+
+  const std::size_t m = src.extent(0);
+  const std::size_t n = src.extent(1);
+  const std::size_t p = src.extent(2);
+
+  mx::NumericArray<double> out     = mx::makeUninitNumericArray<double>({{n, m, p}});
+  mx::NumericArray<double> colSums = mx::makeUninitNumericArray<double>({{1, n, p}});
+
+  auto dst  = out.asMdspan<3>();
+  auto sums = colSums.asMdspan<3>();
+
+  for (std::size_t k{}; k < p; ++k)
+  {
+    const auto srcPage = mx::getPage(src, k);
+
+    /* row i of the source page becomes column i of the destination page */
+    for (std::size_t i{}; i < m; ++i)
+    {
+      const auto row = mx::getRow(src, i, k);
+      const auto col = mx::getColumn(dst, i, k);
+
+      for (std::size_t j{}; j < n; ++j)
+      {
+        col[std::array<std::size_t, 1>{j}] = row[std::array<std::size_t, 1>{j}];
+      }
+    }
+
+    for (std::size_t j{}; j < n; ++j)
+    {
+      /* the j-th column of the page as an M x 1 block */
+      const auto block = mx::getBlock(srcPage, {0, j}, {m, 1});
+
+      double sum{};
+
+      for (std::size_t i{}; i < m; ++i)
+      {
+        sum += block[std::array<std::size_t, 2>{i, 0}];
+      }
+
+      sums[std::array<std::size_t, 3>{0, j, k}] = sum;
+    }
+  }
+
+  lhs[0] = std::move(out);
+
+  if (lhs.size() > 1)
+  {
+    lhs[1] = std::move(colSums);
+  }
+}
@@ -22,11 +22,33 @@ using namespace matlabw;
 static constexpr std::size_t ROWS    = 2;
 static constexpr std::size_t COLUMNS = 2;
 
-void mex::Function::operator()(mx::Span<mx::Array>, mx::View<mx::ArrayCref>)
+void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
 {
   static constexpr std::array<std::uint16_t, 4> data{2, 3, 2, 1};  /* existing data */
 
   static_assert(data.size() == ROWS * COLUMNS);
 
-  throw mx::Exception{"MATLAB:arrayFillSetData:unsupported", "matlab-cpp-wrapper currently does not support setting matrix data."};
+  /* Check for proper number of arguments. */
+  if (!rhs.empty())
+  {
+    throw mx::Exception{"MATLAB:arrayFillSetData:rhs", "This function takes no input arguments."};
+  }
+
+  if (lhs.empty())
+  {
+    return;
+  }
+
+  /* Create a local array and load data */
+  std::unique_ptr<std::uint16_t[], mx::Deleter> dynamicData{mx::calloc<std::uint16_t>(data.size())};
+
+  if (dynamicData == nullptr)
+  {
+    throw mx::Exception{"MATLAB:arrayFillSetData:outOfMemory", "Failed to allocate memory."};
+  }
+
+  std::copy(data.begin(), data.end(), dynamicData.get());
+
+  /* Point the output to dynamicData; the array takes ownership of it */
+  lhs[0] = mx::makeNumericArrayFromBuffer(std::move(dynamicData), ROWS, COLUMNS);
 }
@@ -0,0 +1,130 @@
+/*=================================================================
+ * findnz.c 
+ * Example for illustrating how to handle N-dimensional arrays in a 
+ * MEX-file.  NOTE: MATLAB uses 1 based indexing, C uses 0 based indexing.
+ *
+ * Takes a N-dimensional array of doubles and returns the indices for
+ * the non-zero elements in the array. Findnz works differently than
+ * the FIND command in MATLAB in that it returns all the indices in
+ * one output variable, where the column element contains the index
+ * for that dimension.
+ *
+ * Sparse inputs are handled by iterating over the stored nonzeros.
+ *
+ * This is a MEX-file for MATLAB.  
+ * Copyright 1984-2017 The MathWorks, Inc.
+ *============================================================*/
+
+#include <matlabw/mex/mex.hpp>
+#include <matlabw/mex/Function.hpp>
+
+using namespace matlabw;
+
+/* Computes the indices of the nonzero elements of a full array */
+template<typename T>
+mx::NumericArray<double> findNonzeros(mx::NumericArrayCref<T> input)
+{
+  const mx::View<std::size_t> dims = input.getDims();
+
+  /* Count the number of non-zero elements to be able to allocate
+   * the correct size for output variable */
+  const auto nnz = static_cast<std::size_t>(std::count_if(input.begin(), input.end(), [](const T& value)
+  {
+    return value != T{};
+  }));
+
+  auto output = mx::makeNumericArray<double>(nnz, dims.size());
+
+  /* Fill in the indices to return to MATLAB. The 1 is added to the
+   * calculated index because MATLAB is 1 based and C is zero based. */
+  const T*          data     = input.getData();
+  const std::size_t elements = input.getSize();
+  std::size_t       count{};
+
+  for (std::size_t j{}; j < elements; ++j)
+  {
+    if (data[j] != T{})
+    {
+      std::size_t temp = j;
+
+      for (std::size_t k{}; k < dims.size(); ++k)
+      {
+        output[nnz * k + count] = static_cast<double>(temp % dims[k] + 1);
+        temp /= dims[k];
+      }
+
+      ++count;
+    }
+  }
+
+  return output;
+}
+
+/* Computes the indices of the nonzero elements of a sparse matrix */
+template<typename T>
+mx::NumericArray<double> findNonzeros(mx::SparseArrayCref<T> input)
+{
+  const std::size_t nnz = static_cast<std::size_t>(std::ranges::count_if(input.getNonzeros(), [](const auto& element)
+  {
+    return element.value != T{};
+  }));
+
+  auto output = mx::makeNumericArray<double>(nnz, 2);
+
+  std::size_t count{};
+
+  for (const auto& element : input.getNonzeros())
+  {
+    if (element.value != T{})
+    {
+      output[count]       = static_cast<double>(element.row + 1);
+      output[nnz + count] = static_cast<double>(element.col + 1);
+      ++count;
+    }
+  }
+
+  return output;
+}
+
+void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
+{
+  /* Check for proper number of input and output arguments */    
+  if (rhs.size() != 1)
+  {
+    throw mx::Exception{"MATLAB:findnz:invalidNumInputs", "One input argument required."};
+  }
+
+  if (lhs.size() > 1)
+  {
+    throw mx::Exception{"MATLAB:findnz:maxlhs", "Too many output arguments."};
+  }
+
+  /* Check data type of input argument */
+  if (!rhs[0].isDouble())
+  {
+    throw mx::Exception{"MATLAB:findnz:invalidInputType", "Input array must be of type double."};
+  }
+
+  if (rhs[0].isSparse())
+  {
+    if (rhs[0].isComplex())
+    {
+      lhs[0] = findNonzeros(mx::SparseArrayCref<std::complex<double>>{rhs[0]});
+    }
+    else
+    {
+      lhs[0] = findNonzeros(mx::SparseArrayCref<double>{rhs[0]});
+    }
+  }
+  else
+  {
+    if (rhs[0].isComplex())
+    {
+      lhs[0] = findNonzeros(mx::NumericArrayCref<std::complex<double>>{rhs[0]});
+    }
+    else
+    {
+      lhs[0] = findNonzeros(mx::NumericArrayCref<double>{rhs[0]});
+    }
+  }
+}
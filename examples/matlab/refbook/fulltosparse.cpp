@@ -0,0 +1,97 @@
+/*=================================================================
+ * fulltosparse.c
+ * This example demonstrates how to populate a sparse
+ * matrix.  For the purpose of this example, you must pass in a
+ * non-sparse 2-dimensional argument of type double.
+ *
+ * This is a MEX-file for MATLAB.  
+ * Copyright 1984-2017 The MathWorks, Inc.
+ * All rights reserved.
+ *=================================================================*/
+
+#include <cmath>
+
+#include <matlabw/mex/mex.hpp>
+#include <matlabw/mex/Function.hpp>
+
+using namespace matlabw;
+
+/* Copies the nonzero elements of a full m-by-n matrix to a sparse matrix */
+template<typename T>
+mx::SparseArray<T> fullToSparse(const T* pr, const std::size_t m, const std::size_t n)
+{
+  /* Allocate space for sparse matrix
+   * NOTE:  Assume at most 20% of the data is sparse.  Use ceil
+   * to cause it to round up.
+   */
+  const double percentSparse = 0.2;
+  const auto   nzmax         = static_cast<std::size_t>(std::ceil(static_cast<double>(m) * static_cast<double>(n) * percentSparse));
+
+  auto sparse = mx::makeSparseArray<T>(m, n, nzmax);
+
+  /* Copy nonzeros */
+  std::size_t k{};
+
+  for (std::size_t j{}; j < n; ++j)
+  {
+    sparse.getJc()[j] = k;
+
+    for (std::size_t i{}; i < m; ++i)
+    {
+      if (pr[i] != T{})
+      {
+        /* Make sure the non-zero element fits in the allocated output array.
+         * The capacity grows geometrically, so the reallocation is amortized. */
+        sparse.reserve(k + 1);
+
+        sparse.getPr()[k] = pr[i];
+        sparse.getIr()[k] = i;
+        ++k;
+      }
+    }
+
+    pr += m;
+  }
+
+  sparse.getJc()[n] = k;
+
+  return sparse;
+}
+
+void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs)
+{
+  /* Check for proper number of input and output arguments */
+  if (rhs.size() != 1)
+  {
+    throw mx::Exception{"MATLAB:fulltosparse:invalidNumInputs", "One input argument required."};
+  }
+
+  if (lhs.size() > 1)
+  {
+    throw mx::Exception{"MATLAB:fulltosparse:maxlhs", "Too many output arguments."};
+  }
+
+  /* Check data type of input argument  */
+  if (!rhs[0].isDouble() || rhs[0].isSparse())
+  {
+    throw mx::Exception{"MATLAB:fulltosparse:inputNotDouble", "Input argument must be of type double."};
+  }
+
+  if (rhs[0].getRank() != 2)
+  {
+    throw mx::Exception{"MATLAB:fulltosparse:inputNot2D", "Input argument must be two dimensional\n"};
+  }
+
+  /* Get the size of input data */
+  const std::size_t m = rhs[0].getDimM();
+  const std::size_t n = rhs[0].getDimN();
+
+  if (rhs[0].isComplex())
+  {
+    lhs[0] = fullToSparse(rhs[0].getDataAs<std::complex<double>>(), m, n);
+  }
+  else
+  {
+    lhs[0] = fullToSparse(rhs[0].getDataAs<double>(), m, n);
+  }
+}
@@ -12,6 +12,7 @@
  * Copyright 2009-2018 The MathWorks, Inc.
  *=======================================================*/
 
+#include <memory_resource>
 #include <vector>
 
 #include <lapack.h>
@@ -59,7 +60,8 @@ void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref>
   }
 
   /* DGESV works in-place, so we copy the inputs first. */
-  std::vector<double> Awork{mx::NumericArrayCref<double>{rhs[0]}.begin(), mx::NumericArrayCref<double>{rhs[0]}.end()};
+  std::pmr::vector<double> Awork{mx::NumericArrayCref<double>{rhs[0]}.begin(), mx::NumericArrayCref<double>{rhs[0]}.end(),
+                                 &getArena()};
 
   double* A2 = Awork.data();
 
@@ -70,7 +72,7 @@ void mex::Function::operator()(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref>
   double* B2 = output.getData();
 
   /* Create inputs for DGESV */
-  std::vector<std::ptrdiff_t> pivot(static_cast<std::size_t>(m * p));
+  std::pmr::vector<std::ptrdiff_t> pivot(static_cast<std::size_t>(m * p), &getArena());
 
   std::ptrdiff_t info{};
 
@@ -0,0 +1,357 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MEX_ARRAY_POOL_HPP
+#define MATLABW_MEX_ARRAY_POOL_HPP
+
+#include "detail/include.hpp"
+
+#include "atExit.hpp"
+#include "memory.hpp"
+
+namespace matlabw::mex
+{
+  template<typename T>
+  class PooledArray;
+
+  /**
+   * @brief Pool of persistent arrays recycled between MEX function calls. Arrays are matched by class, complexity
+   *        and dimensions and handed out without reallocating or zeroing their data.
+   *
+   * acquire() returns a PooledArray that gives the array back to the pool when it goes out of scope. Arrays stored
+   * in the pool are made persistent and MATLAB does not allow persistent arrays to be returned through the left-hand
+   * side arguments. Outputs are therefore computed in a pooled array and handed to MATLAB with
+   * PooledArray::makeOutput(), which copies them into a fresh uninitialized array, e.g.
+   * @code
+   *   auto result = mex::getArrayPool().acquire<double>(m, n);
+   *   compute(result.getData(), m, n);
+   *   lhs[0] = result.makeOutput();
+   * @endcode
+   * The copy is a single memcpy, the pool saves the allocations and zeroing of all scratch and intermediate arrays.
+   */
+  class ArrayPool
+  {
+    public:
+      /// @brief Default maximum number of arrays kept in the pool.
+      static constexpr std::size_t defaultMaxSize{64};
+
+      /// @brief Default constructor.
+      ArrayPool() noexcept = default;
+
+      /**
+       * @brief Constructor.
+       * @param maxSize The maximum number of arrays kept in the pool.
+       */
+      explicit ArrayPool(std::size_t maxSize) noexcept
+      : mMaxSize{maxSize}
+      {}
+
+      /// @brief Explicitly deleted copy constructor.
+      ArrayPool(const ArrayPool&) = delete;
+
+      /// @brief Move constructor.
+      ArrayPool(ArrayPool&&) noexcept = default;
+
+      /// @brief Destructor. Destroys all pooled arrays.
+      ~ArrayPool() noexcept = default;
+
+      /// @brief Explicitly deleted copy assignment operator.
+      ArrayPool& operator=(const ArrayPool&) = delete;
+
+      /// @brief Move assignment operator.
+      ArrayPool& operator=(ArrayPool&&) noexcept = default;
+
+      /**
+       * @brief Acquires an array from the pool or creates a new one. The contents of the array are unspecified.
+       * @tparam T The type of the array elements.
+       * @param dims The dimensions of the array.
+       * @return The array, it is given back to the pool when the PooledArray goes out of scope.
+       */
+      template<typename T, std::enable_if_t<mx::isNumeric<T>, int> = 0>
+      [[nodiscard]] PooledArray<T> acquire(mx::View<std::size_t> dims)
+      {
+        return PooledArray<T>{*this, acquireArray<T>(dims)};
+      }
+
+      /**
+       * @brief Acquires a matrix from the pool or creates a new one. The contents of the matrix are unspecified.
+       * @tparam T The type of the matrix elements.
+       * @param m The number of rows.
+       * @param n The number of columns.
+       * @return The matrix, it is given back to the pool when the PooledArray goes out of scope.
+       */
+      template<typename T, std::enable_if_t<mx::isNumeric<T>, int> = 0>
+      [[nodiscard]] PooledArray<T> acquire(std::size_t m, std::size_t n)
+      {
+        return acquire<T>({{m, n}});
+      }
+
+      /**
+       * @brief Gives an array back to the pool. The array is made persistent. If the pool is full, the array is
+       *        destroyed instead.
+       * @param array The array to recycle. Invalid arrays are ignored.
+       */
+      void recycle(mx::Array array)
+      {
+        if (!array.isValid() || mArrays.size() >= mMaxSize)
+        {
+          return;
+        }
+
+        makePersistent(array);
+
+        mArrays.push_back(std::move(array));
+      }
+
+      /// @brief Destroys all pooled arrays.
+      void clear() noexcept
+      {
+        mArrays.clear();
+      }
+
+      /**
+       * @brief Gets the number of pooled arrays.
+       * @return The number of pooled arrays.
+       */
+      [[nodiscard]] std::size_t getSize() const noexcept
+      {
+        return mArrays.size();
+      }
+
+      /**
+       * @brief Gets the maximum number of pooled arrays.
+       * @return The maximum number of pooled arrays.
+       */
+      [[nodiscard]] std::size_t getMaxSize() const noexcept
+      {
+        return mMaxSize;
+      }
+    private:
+      /**
+       * @brief Takes an array out of the pool or creates a new one.
+       * @tparam T The type of the array elements.
+       * @param dims The dimensions of the array.
+       * @return The array.
+       */
+      template<typename T>
+      [[nodiscard]] mx::NumericArray<T> acquireArray(mx::View<std::size_t> dims)
+      {
+        const mx::ClassId    classId    = mx::TypeProperties<T>::classId;
+        const mx::Complexity complexity = mx::TypeProperties<T>::complexity;
+
+        for (auto it = mArrays.rbegin(); it != mArrays.rend(); ++it)
+        {
+          if (it->getClassId() == classId &&
+              it->isComplex() == (complexity == mx::Complexity::complex) &&
+              std::ranges::equal(it->getDims(), dims))
+          {
+            mx::NumericArray<T> array{std::move(*it)};
+
+            std::swap(*it, mArrays.back());
+            mArrays.pop_back();
+
+            return array;
+          }
+        }
+
+        return mx::makeUninitNumericArray<T>(dims);
+      }
+
+      std::vector<mx::Array> mArrays{};               ///< The pooled arrays.
+      std::size_t            mMaxSize{defaultMaxSize}; ///< The maximum number of pooled arrays.
+  };
+
+  /**
+   * @brief Array acquired from an ArrayPool, given back to the pool when it goes out of scope.
+   * @tparam T The type of the array elements.
+   */
+  template<typename T>
+  class PooledArray
+  {
+    public:
+      /**
+       * @brief Constructor.
+       * @param pool The pool the array is given back to, must outlive the PooledArray.
+       * @param array The array.
+       */
+      PooledArray(ArrayPool& pool, mx::NumericArray<T>&& array) noexcept
+      : mPool{&pool}, mArray{std::move(array)}
+      {}
+
+      /// @brief Explicitly deleted copy constructor.
+      PooledArray(const PooledArray&) = delete;
+
+      /// @brief Move constructor.
+      PooledArray(PooledArray&&) noexcept = default;
+
+      /// @brief Destructor. Gives the array back to the pool.
+      ~PooledArray() noexcept
+      {
+        recycle();
+      }
+
+      /// @brief Explicitly deleted copy assignment operator.
+      PooledArray& operator=(const PooledArray&) = delete;
+
+      /**
+       * @brief Move assignment operator. The current array is given back to the pool first.
+       * @param other The other pooled array.
+       * @return Reference to this pooled array.
+       */
+      PooledArray& operator=(PooledArray&& other) noexcept
+      {
+        if (this != std::addressof(other))
+        {
+          recycle();
+
+          mPool  = other.mPool;
+          mArray = std::move(other.mArray);
+        }
+
+        return *this;
+      }
+
+      /**
+       * @brief Creates a non-persistent copy of the array that can be returned through the left-hand side arguments.
+       *        The copy is not zeroed before the data is copied.
+       * @return The copy.
+       */
+      [[nodiscard]] mx::NumericArray<T> makeOutput() const
+      {
+        mx::NumericArray<T> output = mx::makeUninitNumericArray<T>(mArray.getDims());
+
+        std::copy_n(mArray.getData(), mArray.getSize(), output.getData());
+
+        return output;
+      }
+
+      /**
+       * @brief Gets the array.
+       * @return The array.
+       */
+      [[nodiscard]] mx::NumericArray<T>& get() noexcept
+      {
+        return mArray;
+      }
+
+      /**
+       * @brief Gets the array.
+       * @return The array.
+       */
+      [[nodiscard]] const mx::NumericArray<T>& get() const noexcept
+      {
+        return mArray;
+      }
+
+      /**
+       * @brief Gets the data pointer.
+       * @return Data pointer.
+       */
+      [[nodiscard]] T* getData()
+      {
+        return mArray.getData();
+      }
+
+      /**
+       * @brief Gets the data pointer.
+       * @return Const data pointer.
+       */
+      [[nodiscard]] const T* getData() const
+      {
+        return mArray.getData();
+      }
+
+      /**
+       * @brief Accesses the array.
+       * @return Pointer to the array.
+       */
+      [[nodiscard]] mx::NumericArray<T>* operator->() noexcept
+      {
+        return &mArray;
+      }
+
+      /**
+       * @brief Accesses the array.
+       * @return Pointer to the array.
+       */
+      [[nodiscard]] const mx::NumericArray<T>* operator->() const noexcept
+      {
+        return &mArray;
+      }
+
+      /**
+       * @brief Conversion to a reference, e.g. to pass the array to mex::call.
+       * @return Reference to the array.
+       */
+      [[nodiscard]] operator mx::ArrayRef() noexcept
+      {
+        return mArray;
+      }
+
+      /**
+       * @brief Conversion to a const reference, e.g. to pass the array to mex::call.
+       * @return Const reference to the array.
+       */
+      [[nodiscard]] operator mx::ArrayCref() const noexcept
+      {
+        return mArray;
+      }
+    private:
+      /// @brief Gives the array back to the pool.
+      void recycle() noexcept
+      {
+        if (mPool != nullptr && mArray.isValid())
+        {
+          try
+          {
+            mPool->recycle(std::move(mArray));
+          }
+          catch (...)
+          {
+            // the array is destroyed instead of recycled
+          }
+        }
+      }
+
+      ArrayPool*          mPool{};  ///< The pool the array is given back to.
+      mx::NumericArray<T> mArray{}; ///< The array.
+  };
+
+  /**
+   * @brief Gets the array pool shared by all calls of the MEX function. The pool is cleared when the MEX function
+   *        is cleared or MATLAB exits.
+   * @return The array pool.
+   */
+  [[nodiscard]] inline ArrayPool& getArrayPool()
+  {
+    static ArrayPool pool{};
+    static const bool registered = (atExit([]{ pool.clear(); }), true);
+
+    static_cast<void>(registered);
+
+    return pool;
+  }
+} // namespace matlabw::mex
+
+#endif /* MATLABW_MEX_ARRAY_POOL_HPP */
@@ -0,0 +1,350 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MEX_DISPATCHER_HPP
+#define MATLABW_MEX_DISPATCHER_HPP
+
+#include "detail/include.hpp"
+
+namespace matlabw::mex
+{
+  class Function;
+
+  /**
+   * @brief Command handler. Receives the function object and the arguments following the command name.
+   * @param function The function object.
+   * @param lhs The left-hand side arguments.
+   * @param rhs The right-hand side arguments without the command name.
+   */
+  using CommandHandler = void (*)(Function& function, mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs);
+
+  /// @brief Command of a MEX dispatcher.
+  struct Command
+  {
+    std::string_view name{};    ///< The command name, must be ASCII.
+    CommandHandler   handler{}; ///< The command handler.
+  };
+
+namespace detail
+{
+  /**
+   * @brief Hashes a command name. ASCII names hash the same as char and char16_t strings.
+   * @tparam CharT The character type.
+   * @param name The command name.
+   * @param seed The seed.
+   * @return The hash.
+   */
+  template<typename CharT>
+  [[nodiscard]] constexpr std::uint32_t hashCommand(std::basic_string_view<CharT> name, std::uint32_t seed) noexcept
+  {
+    std::uint32_t hash = 2166136261u ^ (seed * 2654435769u);
+
+    for (const CharT c : name)
+    {
+      hash ^= static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<CharT>>(c));
+      hash *= 16777619u;
+    }
+
+    return hash ^ (hash >> 16);
+  }
+} // namespace detail
+
+  /**
+   * @brief Dispatcher of commands selected by a leading char argument, which lets one MEX file export many commands.
+   *        The command names are placed in a perfect hash table at compile time (hash and displace), so a lookup costs
+   *        two hashes of the command token and a single comparison. The token is read as UTF-16 directly from the
+   *        array, no std::string is built.
+   * @tparam N The number of commands.
+   */
+  template<std::size_t N>
+  class Dispatcher
+  {
+    static_assert(N > 0, "dispatcher requires at least one command");
+
+    public:
+      /// @brief The size of the hash table.
+      static constexpr std::size_t tableSize{std::bit_ceil(N)};
+
+      /**
+       * @brief Constructor. Builds the perfect hash table, fails to compile in constant evaluation if the names are not
+       *        unique ASCII strings.
+       * @param commands The commands.
+       */
+      constexpr explicit Dispatcher(const std::array<Command, N>& commands)
+      : mCommands{commands}
+      {
+        for (std::size_t i{}; i < N; ++i)
+        {
+          if (mCommands[i].name.empty() || mCommands[i].handler == nullptr)
+          {
+            throw mx::Exception{"matlabw:mex:Dispatcher:invalidCommand", "invalid command"};
+          }
+
+          if (std::ranges::any_of(mCommands[i].name, [](char c) { return static_cast<unsigned char>(c) > 127; }))
+          {
+            throw mx::Exception{"matlabw:mex:Dispatcher:invalidCommand", "command names must be ASCII"};
+          }
+
+          for (std::size_t j{}; j < i; ++j)
+          {
+            if (mCommands[i].name == mCommands[j].name)
+            {
+              throw mx::Exception{"matlabw:mex:Dispatcher:invalidCommand", "duplicate command name"};
+            }
+          }
+        }
+
+        buildTable();
+      }
+
+      /**
+       * @brief Finds a command.
+       * @tparam CharT The character type, char or char16_t.
+       * @param name The command name.
+       * @return The command or nullptr if there is no such command.
+       */
+      template<typename CharT>
+      [[nodiscard]] constexpr const Command* find(std::basic_string_view<CharT> name) const noexcept
+      {
+        const std::int32_t seed = mSeeds[getBucket(name)];
+        const std::size_t  slot = (seed < 0)
+                                  ? static_cast<std::size_t>(-seed - 1)
+                                  : getSlot(name, static_cast<std::uint32_t>(seed));
+        const std::size_t  i    = mSlots[slot];
+
+        if (i >= N || !std::ranges::equal(name, mCommands[i].name, {}, {},
+                                          [](char c) { return static_cast<CharT>(static_cast<unsigned char>(c)); }))
+        {
+          return nullptr;
+        }
+
+        return &mCommands[i];
+      }
+
+      /**
+       * @brief Finds a command.
+       * @param name The command name.
+       * @return The command or nullptr if there is no such command.
+       */
+      [[nodiscard]] constexpr const Command* find(const char* name) const noexcept
+      {
+        return find(std::string_view{name});
+      }
+
+      /**
+       * @brief Calls the command selected by the first right-hand side argument.
+       * @param function The function object.
+       * @param lhs The left-hand side arguments.
+       * @param rhs The right-hand side arguments, the first one is the command name.
+       */
+      void operator()(Function& function, mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs) const
+      {
+        if (rhs.empty())
+        {
+          throw mx::Exception{"matlabw:mex:Dispatcher:noCommand", "missing command name"};
+        }
+
+        if (rhs.front().getClassId() != mx::ClassId::_char)
+        {
+          throw mx::Exception{"matlabw:mex:Dispatcher:noCommand", "first argument must be a command name"};
+        }
+
+        const mx::CharArrayCref   token{rhs.front(), mx::detail::unchecked};
+        const std::u16string_view name{token.getData(), token.getSize()};
+
+        const Command* command = find(name);
+
+        if (command == nullptr)
+        {
+          std::string message{"unknown command '"};
+
+          std::ranges::transform(name, std::back_inserter(message), [](char16_t c)
+          {
+            return (c < 128) ? static_cast<char>(c) : '?';
+          });
+
+          message += '\'';
+
+          throw mx::Exception{"matlabw:mex:Dispatcher:unknownCommand", std::move(message)};
+        }
+
+        command->handler(function, lhs, rhs.subspan(1));
+      }
+
+      /**
+       * @brief Gets the commands.
+       * @return The commands in the order they were registered.
+       */
+      [[nodiscard]] constexpr mx::View<Command> getCommands() const noexcept
+      {
+        return mCommands;
+      }
+    private:
+      /// @brief Maximum number of seeds tried for a single bucket.
+      static constexpr std::uint32_t maxSeed{1u << 20};
+
+      /**
+       * @brief Gets the bucket of a name.
+       * @tparam CharT The character type.
+       * @param name The name.
+       * @return The bucket.
+       */
+      template<typename CharT>
+      [[nodiscard]] static constexpr std::size_t getBucket(std::basic_string_view<CharT> name) noexcept
+      {
+        return detail::hashCommand(name, 0) & (tableSize - 1);
+      }
+
+      /**
+       * @brief Gets the slot of a name in a displaced bucket.
+       * @tparam CharT The character type.
+       * @param name The name.
+       * @param seed The seed of the bucket.
+       * @return The slot.
+       */
+      template<typename CharT>
+      [[nodiscard]] static constexpr std::size_t getSlot(std::basic_string_view<CharT> name, std::uint32_t seed) noexcept
+      {
+        return detail::hashCommand(name, seed) & (tableSize - 1);
+      }
+
+      /// @brief Builds the table. Buckets are placed from the largest, single command buckets go to free slots.
+      constexpr void buildTable()
+      {
+        std::array<std::size_t, tableSize> bucketSizes{};
+        std::array<std::size_t, tableSize> buckets{};
+        std::array<bool, tableSize>        isUsed{};
+
+        for (const Command& command : mCommands)
+        {
+          ++bucketSizes[getBucket(command.name)];
+        }
+
+        std::iota(buckets.begin(), buckets.end(), std::size_t{});
+        std::ranges::sort(buckets, [&](std::size_t a, std::size_t b)
+        {
+          return (bucketSizes[a] != bucketSizes[b]) ? (bucketSizes[a] > bucketSizes[b]) : (a < b);
+        });
+        std::ranges::fill(mSlots, N);
+
+        std::size_t freeSlot{};
+
+        for (const std::size_t bucket : buckets)
+        {
+          std::array<std::size_t, N> members{};
+          std::size_t                memberCount{};
+
+          for (std::size_t i{}; i < N; ++i)
+          {
+            if (getBucket(mCommands[i].name) == bucket)
+            {
+              members[memberCount++] = i;
+            }
+          }
+
+          if (memberCount == 0)
+          {
+            break;
+          }
+
+          if (memberCount == 1)
+          {
+            while (isUsed[freeSlot])
+            {
+              ++freeSlot;
+            }
+
+            mSeeds[bucket]   = -static_cast<std::int32_t>(freeSlot) - 1;
+            mSlots[freeSlot] = members[0];
+            isUsed[freeSlot] = true;
+            continue;
+          }
+
+          for (std::uint32_t seed{1};; ++seed)
+          {
+            if (seed == maxSeed)
+            {
+              throw mx::Exception{"matlabw:mex:Dispatcher:invalidCommand", "failed to build the command table"};
+            }
+
+            std::array<std::size_t, N> slots{};
+            bool                       isValid{true};
+
+            for (std::size_t k{}; k < memberCount && isValid; ++k)
+            {
+              slots[k] = getSlot(mCommands[members[k]].name, seed);
+              isValid  = !isUsed[slots[k]] && std::find(slots.begin(), slots.begin() + k, slots[k]) == slots.begin() + k;
+            }
+
+            if (isValid)
+            {
+              mSeeds[bucket] = static_cast<std::int32_t>(seed);
+
+              for (std::size_t k{}; k < memberCount; ++k)
+              {
+                mSlots[slots[k]]  = members[k];
+                isUsed[slots[k]] = true;
+              }
+
+              break;
+            }
+          }
+        }
+      }
+
+      std::array<Command, N>              mCommands{}; ///< The commands.
+      std::array<std::int32_t, tableSize> mSeeds{};    ///< The bucket seeds, negative values encode a direct slot.
+      std::array<std::size_t, tableSize>  mSlots{};    ///< The command index per slot, N marks a free slot.
+  };
+
+  /**
+   * @brief Creates a dispatcher.
+   * @tparam N The number of commands.
+   * @param commands The commands.
+   * @return The dispatcher.
+   */
+  template<std::size_t N>
+  [[nodiscard]] constexpr Dispatcher<N> makeDispatcher(const Command (&commands)[N])
+  {
+    return Dispatcher<N>{std::to_array(commands)};
+  }
+} // namespace matlabw::mex
+
+/**
+ * @brief Defines mex::Function::operator() as a dispatcher of the listed commands, e.g.
+ * @code
+ *   MATLABW_MEX_DISPATCH({"add", &add}, {"scale", &scale})
+ * @endcode
+ * The command table is built at compile time. Requires matlabw/mex/Function.hpp to be included.
+ */
+#define MATLABW_MEX_DISPATCH(...)                                                                        \
+  void matlabw::mex::Function::operator()(matlabw::mx::Span<matlabw::mx::Array>     lhs,                 \
+                                          matlabw::mx::View<matlabw::mx::ArrayCref> rhs)                 \
+  {                                                                                                      \
+    static constexpr auto dispatcher = matlabw::mex::makeDispatcher({__VA_ARGS__});                      \
+                                                                                                         \
+    dispatcher(*this, lhs, rhs);                                                                         \
+  }
+
+#endif /* MATLABW_MEX_DISPATCHER_HPP */
@@ -39,20 +39,23 @@ namespace matlabw::mex
        * @brief Gets the name of the function.
        * @return The name of the function.
        */
-      [[nodiscard]] const char* getName() const noexcept
+      [[nodiscard]] const char* getName() const
       {
+        mx::checkThread("matlabw:mex:Function:getName");
         return mexFunctionName();
       }
 
       /// @brief Locks the function.
-      void lock() noexcept
+      void lock()
       {
+        mx::checkThread("matlabw:mex:Function:lock");
         mexLock();
       }
 
       /// @brief Unlocks the function.
-      void unlock() noexcept
+      void unlock()
       {
+        mx::checkThread("matlabw:mex:Function:unlock");
         mexUnlock();
       }
 
@@ -60,11 +63,22 @@ namespace matlabw::mex
        * @brief Checks if the function is locked.
        * @return True if the function is locked, false otherwise.
        */
-      [[nodiscard]] bool isLocked() const noexcept
+      [[nodiscard]] bool isLocked() const
       {
+        mx::checkThread("matlabw:mex:Function:isLocked");
         return mexIsLocked();
       }
 
+      /**
+       * @brief Gets the per-call arena. All memory allocated from it is released in one step when the
+       *        user-defined function returns or throws.
+       * @return The arena.
+       */
+      [[nodiscard]] mx::Arena& getArena() noexcept
+      {
+        return mArena;
+      }
+
       /**
        * @brief Implementation of the user-defined function.
        * @param lhs Left-hand side arguments.
@@ -89,6 +103,8 @@ namespace matlabw::mex
 
       /// @brief Explicitly deleted move assignment operator.
       Function& operator=(Function&&) = delete;
+
+      mx::Arena mArena{}; ///< Per-call arena, released when the function object is destroyed.
   };
 } // namespace matlabw::mex
 
@@ -116,13 +132,17 @@ mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     }
   };
 
+  // Remember the thread MATLAB calls the function on for the thread checks.
+  mx::registerMatlabThread();
+
   try
   {
     // Reinterpret trick requires that the array wrappers have the same size as mxArray*.
     static_assert(sizeof(mxArray*) == sizeof(mx::Array));
     static_assert(sizeof(const mxArray*) == sizeof(mx::ArrayCref));
 
-    // Call the user-defined function.
+    // Call the user-defined function. The temporary function object and its arena are destroyed before
+    // returning or entering one of the handlers below.
     mex::Function{}(mx::Span<mx::Array>(reinterpret_cast<mx::Array*>(plhs), static_cast<std::size_t>(nlhs)),
                     mx::View<mx::ArrayCref>(reinterpret_cast<mx::ArrayCref*>(prhs), static_cast<std::size_t>(nrhs)));
 
@@ -0,0 +1,224 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MEX_FUNCTION_HANDLE_HPP
+#define MATLABW_MEX_FUNCTION_HANDLE_HPP
+
+#include "detail/include.hpp"
+
+#include "eval.hpp"
+#include "memory.hpp"
+
+namespace matlabw::mex
+{
+  /**
+   * @brief Persistent MATLAB function handle for repeated calls from C++, e.g. ODE right-hand-side or objective
+   *        callbacks. The handle is validated once and called through feval with a preallocated right-hand side whose
+   *        first slot is the handle itself. The left-hand and right-hand side storage is reused between calls, so
+   *        calling the handle does not allocate unless more arguments than the reserved capacity are passed.
+   *
+   * The outputs of a call are owned by the function handle, made persistent and remain valid until the next call, also
+   * across MEX calls. They must not be moved into the left-hand side of the MEX function, return a copy instead. Because
+   * the handle and the outputs are persistent, objects with static storage duration should be reset from a mex::atExit
+   * callback.
+   */
+  class FunctionHandle
+  {
+    public:
+      /// @brief Default number of arguments the right-hand side storage is reserved for.
+      static constexpr std::size_t defaultArgCapacity{4};
+
+      /// @brief Default constructor.
+      FunctionHandle() noexcept = default;
+
+      /**
+       * @brief Constructor.
+       * @param handle The function handle. It is duplicated and made persistent.
+       * @param outputCount The number of outputs requested from each call.
+       * @param argCapacity The number of arguments the right-hand side storage is reserved for.
+       */
+      explicit FunctionHandle(mx::ArrayCref handle,
+                              std::size_t   outputCount = 1,
+                              std::size_t   argCapacity = defaultArgCapacity)
+      {
+        mx::checkThread("matlabw:mex:FunctionHandle:FunctionHandle");
+
+        if (handle.getClassId() != mx::ClassId::function)
+        {
+          throw mx::Exception{"matlabw:mex:FunctionHandle:FunctionHandle", "argument must be a function handle"};
+        }
+
+        mHandle = mx::Array{handle};
+        makePersistent(mHandle);
+
+        mRhs.assign(argCapacity + 1, mx::ArrayCref{mHandle});
+        mLhs.resize(outputCount);
+      }
+
+      /**
+       * @brief Constructor. Resolves a function name to a handle with str2func.
+       * @param functionName The name of the function.
+       * @param outputCount The number of outputs requested from each call.
+       * @param argCapacity The number of arguments the right-hand side storage is reserved for.
+       */
+      explicit FunctionHandle(std::string_view functionName,
+                              std::size_t      outputCount = 1,
+                              std::size_t      argCapacity = defaultArgCapacity)
+      {
+        const mx::CharArray name = mx::makeCharArray(functionName);
+        const mx::ArrayCref rhs{name};
+        mx::Array           handle{};
+
+        call(mx::Span<mx::Array>{&handle, 1}, mx::View<mx::ArrayCref>{&rhs, 1}, "str2func");
+
+        *this = FunctionHandle{handle, outputCount, argCapacity};
+      }
+
+      /// @brief Explicitly deleted copy constructor.
+      FunctionHandle(const FunctionHandle&) = delete;
+
+      /// @brief Move constructor.
+      FunctionHandle(FunctionHandle&&) noexcept = default;
+
+      /// @brief Destructor. Destroys the persistent handle and the outputs of the last call.
+      ~FunctionHandle() noexcept = default;
+
+      /// @brief Explicitly deleted copy assignment operator.
+      FunctionHandle& operator=(const FunctionHandle&) = delete;
+
+      /// @brief Move assignment operator.
+      FunctionHandle& operator=(FunctionHandle&&) noexcept = default;
+
+      /**
+       * @brief Calls the function handle.
+       * @param args The arguments, the handle itself must not be included.
+       * @return The persistent outputs of the call, valid until the next call.
+       */
+      mx::Span<mx::Array> operator()(mx::View<mx::ArrayCref> args)
+      {
+        if (!isValid())
+        {
+          throw mx::Exception{"matlabw:mex:FunctionHandle:call", "invalid function handle"};
+        }
+
+        if (args.size() + 1 > mRhs.size())
+        {
+          mRhs.resize(args.size() + 1, mx::ArrayCref{mHandle});
+        }
+
+        std::ranges::copy(args, std::next(mRhs.begin()));
+
+        // the outputs of the previous call are replaced by feval
+        for (mx::Array& output : mLhs)
+        {
+          output = mx::Array{};
+        }
+
+        call(mLhs, mx::View<mx::ArrayCref>{mRhs.data(), args.size() + 1}, "feval");
+
+        // MATLAB frees non-persistent arrays when the MEX call returns, the outputs are destroyed by the next call
+        for (const mx::Array& output : mLhs)
+        {
+          makePersistent(output);
+        }
+
+        return mLhs;
+      }
+
+      /**
+       * @brief Calls the function handle.
+       * @tparam Args The types of the arguments, must be convertible to mx::ArrayCref.
+       * @param args The arguments.
+       * @return The persistent outputs of the call, valid until the next call.
+       */
+      template<typename... Args>
+        requires (std::is_convertible_v<const Args&, mx::ArrayCref> && ...)
+      mx::Span<mx::Array> operator()(const Args&... args)
+      {
+        const std::array<mx::ArrayCref, sizeof...(Args)> rhs{{mx::ArrayCref{args}...}};
+
+        return (*this)(mx::View<mx::ArrayCref>{rhs.data(), rhs.size()});
+      }
+
+      /**
+       * @brief Gets an output of the last call.
+       * @param i The index of the output.
+       * @return The persistent output, copy it to return it to MATLAB.
+       */
+      [[nodiscard]] mx::Array& getOutput(std::size_t i = 0)
+      {
+        return mLhs.at(i);
+      }
+
+      /**
+       * @brief Gets the number of outputs requested from each call.
+       * @return The number of outputs.
+       */
+      [[nodiscard]] std::size_t getOutputCount() const noexcept
+      {
+        return mLhs.size();
+      }
+
+      /**
+       * @brief Sets the number of outputs requested from each call.
+       * @param outputCount The number of outputs.
+       */
+      void setOutputCount(std::size_t outputCount)
+      {
+        mLhs.resize(outputCount);
+      }
+
+      /**
+       * @brief Gets the function handle.
+       * @return The function handle.
+       */
+      [[nodiscard]] mx::ArrayCref getHandle() const
+      {
+        return mx::ArrayCref{mHandle};
+      }
+
+      /**
+       * @brief Checks if the function handle is valid.
+       * @return True if the function handle is valid, false otherwise.
+       */
+      [[nodiscard]] bool isValid() const noexcept
+      {
+        return mHandle.isValid();
+      }
+
+      /// @brief Destroys the handle and the outputs of the last call.
+      void reset() noexcept
+      {
+        mRhs.clear();
+        mLhs.clear();
+        mHandle = mx::Array{};
+      }
+    private:
+      mx::Array                  mHandle{}; ///< The persistent function handle.
+      std::vector<mx::ArrayCref> mRhs{};    ///< The right-hand side, the first slot holds the handle.
+      std::vector<mx::Array>     mLhs{};    ///< The persistent outputs of the last call.
+  };
+} // namespace matlabw::mex
+
+#endif /* MATLABW_MEX_FUNCTION_HANDLE_HPP */
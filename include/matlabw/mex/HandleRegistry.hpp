@@ -0,0 +1,399 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MEX_HANDLE_REGISTRY_HPP
+#define MATLABW_MEX_HANDLE_REGISTRY_HPP
+
+#include "detail/include.hpp"
+
+#include "atExit.hpp"
+
+namespace matlabw::mex
+{
+  namespace detail
+  {
+    /**
+     * @brief Type tag, its address identifies the type T.
+     * @tparam T The type.
+     */
+    template<typename T>
+    inline constexpr char handleTypeTag{};
+  } // namespace detail
+
+  /**
+   * @brief Registry of C++ objects kept alive between MEX function calls and referenced from MATLAB by uint64 handles.
+   *        Handles are resolved in constant time and checked against the type they were created with. A handle encodes
+   *        a slot index and a generation, so handles of removed objects are rejected even after their slot is reused.
+   *
+   * The MEX function is locked while the registry holds any object, so clearing it from MATLAB does not destroy the
+   * objects behind live handles.
+   */
+  class HandleRegistry
+  {
+    public:
+      /// @brief Handle type.
+      using Handle = std::uint64_t;
+
+      /// @brief Invalid handle.
+      static constexpr Handle invalidHandle{};
+
+      /// @brief Default constructor.
+      HandleRegistry() noexcept = default;
+
+      /// @brief Explicitly deleted copy constructor.
+      HandleRegistry(const HandleRegistry&) = delete;
+
+      /// @brief Explicitly deleted move constructor.
+      HandleRegistry(HandleRegistry&&) = delete;
+
+      /// @brief Destructor. Destroys all objects.
+      ~HandleRegistry() noexcept
+      {
+        clear();
+      }
+
+      /// @brief Explicitly deleted copy assignment operator.
+      HandleRegistry& operator=(const HandleRegistry&) = delete;
+
+      /// @brief Explicitly deleted move assignment operator.
+      HandleRegistry& operator=(HandleRegistry&&) = delete;
+
+      /**
+       * @brief Takes ownership of an object.
+       * @tparam T The type of the object.
+       * @param object The object.
+       * @return The handle of the object.
+       */
+      template<typename T>
+      [[nodiscard]] Handle add(std::unique_ptr<T> object)
+      {
+        if (object == nullptr)
+        {
+          throw mx::Exception{"matlabw:mex:HandleRegistry:add", "invalid object"};
+        }
+
+        if (mFreeSlots.empty())
+        {
+          if (mEntries.size() >= std::numeric_limits<std::uint32_t>::max())
+          {
+            throw mx::Exception{"matlabw:mex:HandleRegistry:add", "too many handles"};
+          }
+
+          // the free list can hold every slot, so freeing a slot never allocates
+          mFreeSlots.reserve(mEntries.size() + 1);
+          mEntries.emplace_back();
+          mFreeSlots.push_back(static_cast<std::uint32_t>(mEntries.size() - 1));
+        }
+
+        if (mSize == 0)
+        {
+          lock();
+        }
+
+        const std::uint32_t index = mFreeSlots.back();
+        Entry&              entry = mEntries[index];
+
+        mFreeSlots.pop_back();
+
+        entry.object  = object.release();
+        entry.destroy = [](void* ptr) noexcept { delete static_cast<T*>(ptr); };
+        entry.typeTag = &detail::handleTypeTag<T>;
+
+        ++mSize;
+
+        return makeHandle(index, entry.generation);
+      }
+
+      /**
+       * @brief Takes ownership of an object.
+       * @tparam T The type of the object.
+       * @param object The object.
+       * @return The handle of the object as a uint64 scalar.
+       */
+      template<typename T>
+      [[nodiscard]] mx::NumericArray<std::uint64_t> makeHandleArray(std::unique_ptr<T> object)
+      {
+        return mx::makeNumericScalar<std::uint64_t>(add(std::move(object)));
+      }
+
+      /**
+       * @brief Finds an object.
+       * @tparam T The type of the object.
+       * @param handle The handle.
+       * @return The object or nullptr if the handle is invalid or refers to an object of another type.
+       */
+      template<typename T>
+      [[nodiscard]] T* find(Handle handle) const noexcept
+      {
+        const Entry* entry = findEntry(handle);
+
+        return (entry != nullptr && entry->typeTag == &detail::handleTypeTag<T>) ? static_cast<T*>(entry->object) : nullptr;
+      }
+
+      /**
+       * @brief Gets an object.
+       * @tparam T The type of the object.
+       * @param handle The handle.
+       * @return The object.
+       */
+      template<typename T>
+      [[nodiscard]] T& get(Handle handle) const
+      {
+        const Entry& entry = getEntry(handle);
+
+        if (entry.typeTag != &detail::handleTypeTag<T>)
+        {
+          throw mx::Exception{"matlabw:mex:HandleRegistry:typeMismatch", "handle refers to an object of another type"};
+        }
+
+        return *static_cast<T*>(entry.object);
+      }
+
+      /**
+       * @brief Gets an object.
+       * @tparam T The type of the object.
+       * @param handle The handle as a real uint64 scalar.
+       * @return The object.
+       */
+      template<typename T>
+      [[nodiscard]] T& get(mx::ArrayCref handle) const
+      {
+        return get<T>(toHandle(handle));
+      }
+
+      /**
+       * @brief Releases the ownership of an object.
+       * @tparam T The type of the object.
+       * @param handle The handle.
+       * @return The object.
+       */
+      template<typename T>
+      [[nodiscard]] std::unique_ptr<T> release(Handle handle)
+      {
+        std::unique_ptr<T> object{&get<T>(handle)};
+
+        freeEntry(getEntry(handle));
+
+        return object;
+      }
+
+      /**
+       * @brief Destroys an object.
+       * @param handle The handle.
+       */
+      void remove(Handle handle)
+      {
+        Entry&        entry   = getEntry(handle);
+        void* const   object  = entry.object;
+        const Destroy destroy = entry.destroy;
+
+        freeEntry(entry);
+
+        destroy(object);
+      }
+
+      /**
+       * @brief Destroys an object.
+       * @param handle The handle as a real uint64 scalar.
+       */
+      void remove(mx::ArrayCref handle)
+      {
+        remove(toHandle(handle));
+      }
+
+      /**
+       * @brief Checks if a handle refers to a live object.
+       * @param handle The handle.
+       * @return True if the handle refers to a live object, false otherwise.
+       */
+      [[nodiscard]] bool contains(Handle handle) const noexcept
+      {
+        return findEntry(handle) != nullptr;
+      }
+
+      /**
+       * @brief Gets the number of live objects.
+       * @return The number of live objects.
+       */
+      [[nodiscard]] std::size_t size() const noexcept
+      {
+        return mSize;
+      }
+
+      /**
+       * @brief Checks if the registry holds no objects.
+       * @return True if the registry is empty, false otherwise.
+       */
+      [[nodiscard]] bool empty() const noexcept
+      {
+        return mSize == 0;
+      }
+
+      /// @brief Destroys all objects. Handles created before remain invalid.
+      void clear() noexcept
+      {
+        for (std::size_t i{}; i < mEntries.size(); ++i)
+        {
+          Entry& entry = mEntries[i];
+
+          if (entry.object != nullptr)
+          {
+            void* const   object  = entry.object;
+            const Destroy destroy = entry.destroy;
+
+            freeEntry(entry);
+
+            destroy(object);
+          }
+        }
+      }
+    private:
+      /// @brief Object deleter type.
+      using Destroy = void (*)(void*) noexcept;
+
+      /// @brief Slot of the registry.
+      struct Entry
+      {
+        void*         object{};     ///< The object, nullptr if the slot is free.
+        Destroy       destroy{};    ///< Destroys the object.
+        const void*   typeTag{};    ///< The type tag of the object.
+        std::uint32_t generation{}; ///< Incremented every time the slot is freed.
+      };
+
+      /**
+       * @brief Makes a handle. Slot indices are stored one-based, so no handle is zero.
+       * @param index The slot index.
+       * @param generation The slot generation.
+       * @return The handle.
+       */
+      [[nodiscard]] static constexpr Handle makeHandle(std::uint32_t index, std::uint32_t generation) noexcept
+      {
+        return (static_cast<Handle>(generation) << 32) | (static_cast<Handle>(index) + 1);
+      }
+
+      /**
+       * @brief Converts an array to a handle.
+       * @param array The real uint64 scalar.
+       * @return The handle.
+       */
+      [[nodiscard]] static Handle toHandle(mx::ArrayCref array)
+      {
+        if (array.getClassId() != mx::ClassId::uint64 || array.isComplex() || array.getSize() != 1)
+        {
+          throw mx::Exception{"matlabw:mex:HandleRegistry:invalidHandle", "handle must be a real uint64 scalar"};
+        }
+
+        return *mx::TypedArrayCref<std::uint64_t>{array, mx::detail::unchecked}.getData();
+      }
+
+      /**
+       * @brief Finds the entry of a live object.
+       * @param handle The handle.
+       * @return The entry or nullptr if the handle is invalid.
+       */
+      [[nodiscard]] const Entry* findEntry(Handle handle) const noexcept
+      {
+        const std::uint64_t index      = (handle & 0xffff'ffffu) - 1;
+        const std::uint32_t generation = static_cast<std::uint32_t>(handle >> 32);
+
+        if (index >= mEntries.size())
+        {
+          return nullptr;
+        }
+
+        const Entry& entry = mEntries[static_cast<std::size_t>(index)];
+
+        return (entry.object != nullptr && entry.generation == generation) ? &entry : nullptr;
+      }
+
+      /**
+       * @brief Gets the entry of a live object.
+       * @param handle The handle.
+       * @return The entry.
+       */
+      [[nodiscard]] Entry& getEntry(Handle handle) const
+      {
+        const Entry* entry = findEntry(handle);
+
+        if (entry == nullptr)
+        {
+          throw mx::Exception{"matlabw:mex:HandleRegistry:invalidHandle", "invalid or deleted handle"};
+        }
+
+        return const_cast<Entry&>(*entry);
+      }
+
+      /**
+       * @brief Frees an entry without destroying its object. Unlocks the MEX function when the last object is freed.
+       * @param entry The entry.
+       */
+      void freeEntry(Entry& entry) noexcept
+      {
+        entry.object  = nullptr;
+        entry.typeTag = nullptr;
+        ++entry.generation;
+
+        mFreeSlots.push_back(static_cast<std::uint32_t>(&entry - mEntries.data()));
+
+        if (--mSize == 0)
+        {
+          unlock();
+        }
+      }
+
+      /// @brief Locks the MEX function.
+      static void lock()
+      {
+        mx::checkThread("matlabw:mex:HandleRegistry:lock");
+        mexLock();
+      }
+
+      /// @brief Unlocks the MEX function.
+      static void unlock() noexcept
+      {
+        mexUnlock();
+      }
+
+      std::vector<Entry>         mEntries{};   ///< The slots.
+      std::vector<std::uint32_t> mFreeSlots{}; ///< The indices of the free slots.
+      std::size_t                mSize{};      ///< The number of live objects.
+  };
+
+  /**
+   * @brief Gets the handle registry shared by all calls of the MEX function. All objects are destroyed when the MEX
+   *        function is cleared or MATLAB exits.
+   * @return The handle registry.
+   */
+  [[nodiscard]] inline HandleRegistry& getHandleRegistry()
+  {
+    static HandleRegistry registry{};
+    static const bool     registered = (atExit([]{ registry.clear(); }), true);
+
+    static_cast<void>(registered);
+
+    return registry;
+  }
+} // namespace matlabw::mex
+
+#endif /* MATLABW_MEX_HANDLE_REGISTRY_HPP */
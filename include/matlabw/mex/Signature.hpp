@@ -0,0 +1,414 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MEX_SIGNATURE_HPP
+#define MATLABW_MEX_SIGNATURE_HPP
+
+#include "detail/include.hpp"
+
+namespace matlabw::mex
+{
+namespace arg
+{
+  /// @brief Shape constraint of an argument.
+  enum class Shape
+  {
+    any,          ///< Any dimensions.
+    scalar,       ///< 1x1.
+    vector,       ///< 1xN or Nx1.
+    rowVector,    ///< 1xN.
+    columnVector, ///< Nx1.
+    matrix,       ///< MxN without trailing dimensions.
+    string,       ///< 1xN or empty, e.g. '' is 0x0.
+  };
+} // namespace arg
+
+namespace detail
+{
+  /**
+   * @brief Gets the name of a shape.
+   * @param shape The shape.
+   * @return The shape name.
+   */
+  [[nodiscard]] constexpr std::string_view getShapeName(arg::Shape shape) noexcept
+  {
+    switch (shape)
+    {
+      case arg::Shape::scalar:       return "scalar";
+      case arg::Shape::vector:       return "vector";
+      case arg::Shape::rowVector:    return "row vector";
+      case arg::Shape::columnVector: return "column vector";
+      case arg::Shape::matrix:       return "matrix";
+      case arg::Shape::string:       return "row vector or empty array";
+      default:                       return "array";
+    }
+  }
+
+  /**
+   * @brief Checks if dimensions satisfy a shape constraint.
+   * @param dims The dimensions.
+   * @param shape The shape.
+   * @return True if the dimensions satisfy the constraint, false otherwise.
+   */
+  [[nodiscard]] constexpr bool hasShape(mx::View<std::size_t> dims, arg::Shape shape) noexcept
+  {
+    const bool        isMatrix = dims.size() == 2;
+    const std::size_t m        = (dims.size() > 0) ? dims[0] : 0;
+    const std::size_t n        = (dims.size() > 1) ? dims[1] : 0;
+
+    switch (shape)
+    {
+      case arg::Shape::scalar:
+        return std::ranges::all_of(dims, [](std::size_t dim) { return dim == 1; });
+      case arg::Shape::vector:
+        return isMatrix && (m == 1 || n == 1);
+      case arg::Shape::rowVector:
+        return isMatrix && m == 1;
+      case arg::Shape::columnVector:
+        return isMatrix && n == 1;
+      case arg::Shape::matrix:
+        return isMatrix;
+      case arg::Shape::string:
+        return (isMatrix && m == 1) || std::ranges::find(dims, std::size_t{}) != dims.end();
+      default:
+        return true;
+    }
+  }
+
+  /**
+   * @brief Throws an invalid argument exception.
+   * @param id The error ID.
+   * @param index The zero-based index of the argument.
+   * @param expected The description of the expected argument.
+   */
+  [[noreturn]] inline void throwInvalidArgument(const char* id, std::size_t index, std::string_view expected)
+  {
+    std::string message{"invalid argument "};
+
+    message += std::to_string(index + 1);
+    message += ", expected ";
+    message += expected;
+
+    throw mx::Exception{id, std::move(message)};
+  }
+
+  /**
+   * @brief Typed reference returned for a validated argument of class T.
+   * @tparam T The type of the array elements.
+   */
+  template<typename T>
+  struct ArgumentRefHelper
+  {
+    using Type = mx::TypedArrayCref<T>;
+  };
+
+  /// @brief Specialization of ArgumentRefHelper for char arrays.
+  template<>
+  struct ArgumentRefHelper<char16_t>
+  {
+    using Type = mx::CharArrayCref;
+  };
+
+  /// @brief Specialization of ArgumentRefHelper for struct arrays.
+  template<>
+  struct ArgumentRefHelper<mx::Struct>
+  {
+    using Type = mx::StructArrayCref;
+  };
+} // namespace detail
+
+namespace arg
+{
+  /**
+   * @brief Argument of class T satisfying a shape constraint. Numeric arguments must have the complexity of T, numeric
+   *        and logical arguments must be full.
+   * @tparam T The type of the array elements, a numeric type, bool, char16_t, mx::Cell or mx::Struct.
+   * @tparam shape The shape constraint.
+   */
+  template<typename T, Shape shape = Shape::any>
+  struct Array
+  {
+    static_assert(mx::isNumeric<T> || std::is_same_v<T, bool> || std::is_same_v<T, char16_t>
+                  || std::is_same_v<T, mx::Cell> || std::is_same_v<T, mx::Struct>,
+                  "unsupported argument type");
+
+    /// @brief The typed reference the argument is returned as.
+    using Result = typename detail::ArgumentRefHelper<T>::Type;
+
+    /// @brief Whether the argument may be omitted.
+    static constexpr bool isOptional{false};
+
+    /**
+     * @brief Validates the argument. The class and the dimensions are read once.
+     * @param array The argument.
+     * @param index The zero-based index of the argument, used in error messages.
+     * @return The typed reference.
+     */
+    [[nodiscard]] static Result check(mx::ArrayCref array, std::size_t index)
+    {
+      if (array.getClassId() != mx::TypeProperties<T>::classId)
+      {
+        detail::throwInvalidArgument("matlabw:mex:Signature:argumentClass", index, describe());
+      }
+
+      if constexpr (mx::isNumeric<T> || std::is_same_v<T, bool>)
+      {
+        if (array.isSparse())
+        {
+          detail::throwInvalidArgument("matlabw:mex:Signature:argumentSparsity", index, describe());
+        }
+      }
+
+      if constexpr (mx::isNumeric<T>)
+      {
+        if (array.isComplex() != mx::isComplexNumeric<T>)
+        {
+          detail::throwInvalidArgument("matlabw:mex:Signature:argumentComplexity", index, describe());
+        }
+      }
+
+      if constexpr (shape != Shape::any)
+      {
+        if (!detail::hasShape(array.getDims(), shape))
+        {
+          detail::throwInvalidArgument("matlabw:mex:Signature:argumentShape", index, describe());
+        }
+      }
+
+      return Result{array, mx::detail::unchecked};
+    }
+
+    /**
+     * @brief Describes the expected argument, e.g. "real double row vector".
+     * @return The description.
+     */
+    [[nodiscard]] static std::string describe()
+    {
+      std::string description{};
+
+      if constexpr (mx::isNumeric<T>)
+      {
+        description += mx::isComplexNumeric<T> ? "complex " : "real ";
+      }
+
+      description += mx::detail::getClassName(mx::TypeProperties<T>::classId);
+      description += ' ';
+      description += detail::getShapeName(shape);
+
+      return description;
+    }
+  };
+
+  /**
+   * @brief Scalar argument.
+   * @tparam T The type of the array elements.
+   */
+  template<typename T>
+  using Scalar = Array<T, Shape::scalar>;
+
+  /**
+   * @brief Row or column vector argument.
+   * @tparam T The type of the array elements.
+   */
+  template<typename T>
+  using Vector = Array<T, Shape::vector>;
+
+  /**
+   * @brief Row vector argument.
+   * @tparam T The type of the array elements.
+   */
+  template<typename T>
+  using RowVector = Array<T, Shape::rowVector>;
+
+  /**
+   * @brief Column vector argument.
+   * @tparam T The type of the array elements.
+   */
+  template<typename T>
+  using ColumnVector = Array<T, Shape::columnVector>;
+
+  /**
+   * @brief Matrix argument.
+   * @tparam T The type of the array elements.
+   */
+  template<typename T>
+  using Matrix = Array<T, Shape::matrix>;
+
+  /// @brief Logical array argument.
+  using Logical = Array<bool>;
+
+  /// @brief Char array argument.
+  using Char = Array<char16_t>;
+
+  /// @brief Char row vector argument, empty char arrays such as '' are accepted as well.
+  using String = Array<char16_t, Shape::string>;
+
+  /// @brief Cell array argument.
+  using Cell = Array<mx::Cell>;
+
+  /// @brief Struct array argument.
+  using Struct = Array<mx::Struct>;
+
+  /// @brief Argument of any class, returned unchanged.
+  struct Any
+  {
+    /// @brief The reference the argument is returned as.
+    using Result = mx::ArrayCref;
+
+    /// @brief Whether the argument may be omitted.
+    static constexpr bool isOptional{false};
+
+    /**
+     * @brief Returns the argument unchanged.
+     * @param array The argument.
+     * @return The argument.
+     */
+    [[nodiscard]] static Result check(mx::ArrayCref array, std::size_t) noexcept
+    {
+      return array;
+    }
+  };
+
+  /**
+   * @brief Optional trailing argument, returned as std::nullopt if omitted.
+   * @tparam Arg The argument specification.
+   */
+  template<typename Arg>
+  struct Optional
+  {
+    static_assert(!Arg::isOptional, "optional arguments cannot be nested");
+
+    /// @brief The reference the argument is returned as.
+    using Result = std::optional<typename Arg::Result>;
+
+    /// @brief Whether the argument may be omitted.
+    static constexpr bool isOptional{true};
+
+    /**
+     * @brief Validates the argument.
+     * @param array The argument.
+     * @param index The zero-based index of the argument, used in error messages.
+     * @return The reference.
+     */
+    [[nodiscard]] static Result check(mx::ArrayCref array, std::size_t index)
+    {
+      return Arg::check(array, index);
+    }
+  };
+} // namespace arg
+
+  /**
+   * @brief Declarative signature of the right-hand side arguments of a MEX function. Validating the arguments reads the
+   *        class and the dimensions of each argument once and returns already typed references, so the arguments do not
+   *        have to be checked again, e.g.
+   * @code
+   *   auto [x, y, opts] = mex::Signature<arg::Scalar<double>, arg::RowVector<double>, arg::Optional<arg::Struct>>::validate(rhs);
+   * @endcode
+   *
+   * Errors are reported with the IDs matlabw:mex:Signature:nrhs, :argumentClass, :argumentSparsity,
+   * :argumentComplexity and :argumentShape.
+   * @tparam Args The argument specifications from the mex::arg namespace. Optional arguments must be trailing.
+   */
+  template<typename... Args>
+  class Signature
+  {
+    public:
+      /// @brief The tuple of references returned by validate().
+      using Result = std::tuple<typename Args::Result...>;
+
+      /// @brief The maximum number of arguments.
+      static constexpr std::size_t maxArgCount{sizeof...(Args)};
+
+      /// @brief The minimum number of arguments.
+      static constexpr std::size_t minArgCount{(std::size_t{!Args::isOptional} + ... + std::size_t{})};
+
+      static_assert(std::ranges::is_sorted(std::array<bool, sizeof...(Args)>{Args::isOptional...}),
+                    "optional arguments must be trailing");
+
+      /**
+       * @brief Validates the right-hand side arguments.
+       * @param rhs The right-hand side arguments.
+       * @return The typed references, in the order of the arguments.
+       */
+      [[nodiscard]] static Result validate(mx::View<mx::ArrayCref> rhs)
+      {
+        if (rhs.size() < minArgCount || rhs.size() > maxArgCount)
+        {
+          std::string message{"expected "};
+
+          message += std::to_string(minArgCount);
+
+          if constexpr (minArgCount != maxArgCount)
+          {
+            message += " to ";
+            message += std::to_string(maxArgCount);
+          }
+
+          message += " arguments, got ";
+          message += std::to_string(rhs.size());
+
+          throw mx::Exception{"matlabw:mex:Signature:nrhs", std::move(message)};
+        }
+
+        return validate(rhs, std::index_sequence_for<Args...>{});
+      }
+    private:
+      /**
+       * @brief Validates the right-hand side arguments.
+       * @tparam is The indices of the arguments.
+       * @param rhs The right-hand side arguments.
+       * @return The typed references.
+       */
+      template<std::size_t... is>
+      [[nodiscard]] static Result validate(mx::View<mx::ArrayCref> rhs, std::index_sequence<is...>)
+      {
+        // braced initialization checks the arguments from left to right
+        return Result{checkAt<is>(rhs)...};
+      }
+
+      /**
+       * @brief Validates a single argument.
+       * @tparam i The index of the argument.
+       * @param rhs The right-hand side arguments.
+       * @return The typed reference.
+       */
+      template<std::size_t i>
+      [[nodiscard]] static std::tuple_element_t<i, Result> checkAt(mx::View<mx::ArrayCref> rhs)
+      {
+        using Arg = std::tuple_element_t<i, std::tuple<Args...>>;
+
+        if constexpr (Arg::isOptional)
+        {
+          if (i >= rhs.size())
+          {
+            return std::nullopt;
+          }
+        }
+
+        return Arg::check(rhs[i], i);
+      }
+  };
+} // namespace matlabw::mex
+
+#endif /* MATLABW_MEX_SIGNATURE_HPP */
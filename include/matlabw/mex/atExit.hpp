@@ -0,0 +1,88 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MEX_AT_EXIT_HPP
+#define MATLABW_MEX_AT_EXIT_HPP
+
+#include "detail/include.hpp"
+
+namespace matlabw::mex
+{
+  namespace detail
+  {
+    /**
+     * @brief Gets the callbacks to be run when the MEX function is cleared.
+     * @return The callbacks in registration order.
+     */
+    [[nodiscard]] inline std::vector<std::function<void()>>& getAtExitCallbacks() noexcept
+    {
+      static std::vector<std::function<void()>> callbacks{};
+
+      return callbacks;
+    }
+
+    /// @brief Runs the registered callbacks in reverse registration order. Registered with mexAtExit.
+    inline void runAtExitCallbacks() noexcept
+    {
+      auto& callbacks = getAtExitCallbacks();
+
+      while (!callbacks.empty())
+      {
+        auto callback = std::move(callbacks.back());
+        callbacks.pop_back();
+
+        try
+        {
+          callback();
+        }
+        catch (...)
+        {
+          // Nothing sensible can be done while the MEX function is being cleared.
+        }
+      }
+    }
+  } // namespace detail
+
+  /**
+   * @brief Registers a callback to be run when the MEX function is cleared or MATLAB exits. Callbacks are run in
+   *        reverse registration order. Unlike mexAtExit, multiple callbacks may be registered. Calling mexAtExit
+   *        directly replaces the handler that runs them.
+   * @param callback The callback to register.
+   */
+  inline void atExit(std::function<void()> callback)
+  {
+    mx::checkThread("matlabw:mex:atExit");
+
+    if (!callback)
+    {
+      throw mx::Exception{"matlabw:mex:atExit", "invalid callback"};
+    }
+
+    detail::getAtExitCallbacks().push_back(std::move(callback));
+
+    mexAtExit(detail::runAtExitCallbacks);
+  }
+} // namespace matlabw::mex
+
+#endif /* MATLABW_MEX_AT_EXIT_HPP */
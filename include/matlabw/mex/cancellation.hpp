@@ -0,0 +1,74 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MEX_CANCELLATION_HPP
+#define MATLABW_MEX_CANCELLATION_HPP
+
+#include "detail/include.hpp"
+
+#include "eval.hpp"
+#include "variable.hpp"
+
+namespace matlabw::mex
+{
+  /// @brief Cancellation token polled by long-running kernels, see mx::CancellationToken.
+  using CancellationToken = mx::CancellationToken;
+
+  /**
+   * @brief Creates an interrupt source that requests cancellation once a workspace variable holds a nonzero real
+   *        scalar, e.g. a global flag set by a stop button callback. MATLAB runs no callbacks while a MEX function
+   *        executes, so by default the source flushes the event queue with drawnow before reading the variable.
+   * @param workspace The workspace of the variable.
+   * @param name The name of the variable.
+   * @param processEvents Whether to call drawnow before reading the variable.
+   * @return The interrupt source.
+   */
+  [[nodiscard]] inline CancellationToken::Source
+  makeWorkspaceCancellationSource(Workspace workspace, std::string name, bool processEvents = true)
+  {
+    return [workspace, name = std::move(name), processEvents]
+    {
+      if (processEvents)
+      {
+        call({}, "drawnow");
+      }
+
+      const std::optional<mx::ArrayCref> value = getVariableCref(workspace, name.c_str());
+
+      if (!value || !value->isScalar() || value->isComplex())
+      {
+        return false;
+      }
+
+      if (value->isLogical())
+      {
+        return value->isLogicalScalarTrue();
+      }
+
+      return value->isNumeric() && mxGetScalar(value->get()) != 0.0;
+    };
+  }
+} // namespace matlabw::mex
+
+#endif /* MATLABW_MEX_CANCELLATION_HPP */
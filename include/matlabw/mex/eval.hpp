@@ -38,6 +38,8 @@ namespace matlabw::mex
    */
   inline void call(mx::Span<mx::Array> lhs, mx::View<mx::ArrayCref> rhs, const char* functionName)
   {
+    mx::checkThread("matlabw:mex:call");
+
     if (!std::empty(lhs) && std::data(lhs) == nullptr)
     {
       throw mx::Exception{"invalid output"};
@@ -106,6 +108,8 @@ namespace matlabw::mex
    */
   inline void eval(const char* expr)
   {
+    mx::checkThread("matlabw:mex:eval");
+
     if (expr == nullptr)
     {
       throw mx::Exception{"invalid expression"};
@@ -122,6 +126,161 @@ namespace matlabw::mex
   {
     eval(expr.data());
   }
+
+  /// @brief Default maximum number of calls packed into a single callBatch round trip.
+  inline constexpr std::size_t defaultBatchChunkSize{4096};
+
+  /**
+   * @brief Calls a MATLAB function once per argument set with a single cellfun call per chunk, which amortizes the
+   *        cost of a MATLAB round trip over many small calls. The arguments are copied into cell arrays, the chunk
+   *        size caps the number of copies alive at once. Each call must return exactly one output.
+   * @param function The function handle or the name of the function.
+   * @param rhsBatches The argument sets, all of them must have the same number of arguments.
+   * @param chunkSize The maximum number of calls per cellfun call.
+   * @return The output of each call in the order of the argument sets.
+   */
+  [[nodiscard]] inline std::vector<mx::Array> callBatch(mx::ArrayCref                     function,
+                                                        mx::View<mx::View<mx::ArrayCref>> rhsBatches,
+                                                        std::size_t                       chunkSize = defaultBatchChunkSize)
+  {
+    mx::checkThread("matlabw:mex:callBatch");
+
+    if (chunkSize == 0)
+    {
+      throw mx::Exception{"matlabw:mex:callBatch", "invalid chunk size"};
+    }
+
+    std::vector<mx::Array> results{};
+
+    if (rhsBatches.empty())
+    {
+      return results;
+    }
+
+    const std::size_t callCount = rhsBatches.size();
+    const std::size_t argCount  = rhsBatches.front().size();
+
+    for (const mx::View<mx::ArrayCref> rhs : rhsBatches)
+    {
+      if (rhs.size() != argCount)
+      {
+        throw mx::Exception{"matlabw:mex:callBatch", "all argument sets must have the same number of arguments"};
+      }
+    }
+
+    // cellfun requires a function handle
+    mx::Array handle{};
+
+    if (function.isChar())
+    {
+      call(mx::Span<mx::Array>{&handle, 1}, mx::View<mx::ArrayCref>{&function, 1}, "str2func");
+      function = mx::ArrayCref{handle.get()};
+    }
+
+    const mx::CharArray    uniformOutput = mx::makeCharArray("UniformOutput");
+    const mx::LogicalArray isUniform     = mx::makeLogicalScalar(false);
+
+    std::vector<mx::CellArray> cells{};
+    std::vector<mx::ArrayCref> rhs{};
+
+    results.reserve(callCount);
+    cells.reserve(argCount);
+    rhs.reserve(argCount + 3);
+
+    for (std::size_t begin{}; begin < callCount; begin += chunkSize)
+    {
+      const std::size_t count = std::min(chunkSize, callCount - begin);
+
+      cells.clear();
+      rhs.clear();
+      rhs.push_back(function);
+
+      for (std::size_t j{}; j < argCount; ++j)
+      {
+        mx::CellArray& cell = cells.emplace_back(mx::makeCellArray(1, count));
+
+        for (std::size_t i{}; i < count; ++i)
+        {
+          cell[i] = rhsBatches[begin + i][j];
+        }
+
+        rhs.push_back(cell);
+      }
+
+      rhs.push_back(uniformOutput);
+      rhs.push_back(isUniform);
+
+      mx::Array output{};
+
+      call(mx::Span<mx::Array>{&output, 1}, rhs, "cellfun");
+
+      if (!output.isCell() || output.getSize() != count)
+      {
+        throw mx::Exception{"matlabw:mex:callBatch", "unexpected cellfun output"};
+      }
+
+      mx::CellArray outputs{std::move(output)};
+
+      // take the outputs over from the cell array instead of copying them
+      for (std::size_t i{}; i < count; ++i)
+      {
+        results.push_back(std::move(outputs[i]));
+      }
+    }
+
+    return results;
+  }
+
+  /**
+   * @brief Calls a MATLAB function with a single argument once per argument, see callBatch.
+   * @param function The function handle or the name of the function.
+   * @param rhs The arguments, one per call.
+   * @param chunkSize The maximum number of calls per cellfun call.
+   * @return The output of each call in the order of the arguments.
+   */
+  [[nodiscard]] inline std::vector<mx::Array> callBatch(mx::ArrayCref           function,
+                                                        mx::View<mx::ArrayCref> rhs,
+                                                        std::size_t             chunkSize = defaultBatchChunkSize)
+  {
+    std::vector<mx::View<mx::ArrayCref>> rhsBatches{};
+
+    rhsBatches.reserve(rhs.size());
+
+    for (const mx::ArrayCref& arg : rhs)
+    {
+      rhsBatches.emplace_back(&arg, 1);
+    }
+
+    return callBatch(function, rhsBatches, chunkSize);
+  }
+
+  /**
+   * @brief Calls a MATLAB function once per argument set, see callBatch.
+   * @param functionName The name of the function.
+   * @param rhsBatches The argument sets, all of them must have the same number of arguments.
+   * @param chunkSize The maximum number of calls per cellfun call.
+   * @return The output of each call in the order of the argument sets.
+   */
+  [[nodiscard]] inline std::vector<mx::Array> callBatch(std::string_view                  functionName,
+                                                        mx::View<mx::View<mx::ArrayCref>> rhsBatches,
+                                                        std::size_t                       chunkSize = defaultBatchChunkSize)
+  {
+    return callBatch(mx::makeCharArray(functionName), rhsBatches, chunkSize);
+  }
+
+  /**
+   * @brief Calls a MATLAB function with a single argument once per argument, see callBatch.
+   * @param functionName The name of the function.
+   * @param rhs The arguments, one per call.
+   * @param chunkSize The maximum number of calls per cellfun call.
+   * @return The output of each call in the order of the arguments.
+   */
+  [[nodiscard]] inline std::vector<mx::Array> callBatch(std::string_view        functionName,
+                                                        mx::View<mx::ArrayCref> rhs,
+                                                        std::size_t             chunkSize = defaultBatchChunkSize)
+  {
+    return callBatch(mx::makeCharArray(functionName), rhs, chunkSize);
+  }
 } // namespace matlabw::mex
 
 #endif /* MATLABW_MEX_EVAL_HPP */
@@ -38,6 +38,8 @@ namespace matlabw::mex
   template<typename... Args>
   void printf(const char* format, Args&&... args)
   {
+    mx::checkThread("matlabw:mex:printf");
+
     if constexpr (sizeof...(Args) > 0)
     {
       mexPrintf(format, std::forward<Args>(args)...);
@@ -66,6 +68,7 @@ namespace matlabw::mex
    */
   inline void warn(const char* message)
   {
+    mx::checkThread("matlabw:mex:warn");
     mexWarnMsgTxt(message);
   }
 
@@ -88,6 +91,8 @@ namespace matlabw::mex
   template<typename... Args>
   void warn(const char* id, const char* format, Args&&... args)
   {
+    mx::checkThread("matlabw:mex:warn");
+
     if constexpr (sizeof...(Args) > 0)
     {
       mexWarnMsgIdAndTxt(id, format, std::forward<Args>(args)...);
@@ -33,8 +33,9 @@ namespace matlabw::mex
    * @brief Makes the specified memory persistent between MEX function calls.
    * @param ptr A pointer to the memory to make persistent.
    */
-  void makePersistent(const void* ptr)
+  inline void makePersistent(const void* ptr)
   {
+    mx::checkThread("matlabw:mex:makePersistent");
     mexMakeMemoryPersistent(const_cast<void*>(ptr));
   }
 
@@ -42,8 +43,10 @@ namespace matlabw::mex
    * @brief Makes the specified memory persistent between MEX function calls.
    * @param array An array whose memory to make persistent.
    */
-  void makePersistent(const mx::Array& array)
+  inline void makePersistent(const mx::Array& array)
   {
+    mx::checkThread("matlabw:mex:makePersistent");
+
     if (array.isValid())
     {
       mexMakeArrayPersistent(const_cast<mxArray*>(array.get()));
@@ -25,9 +25,17 @@
 #ifndef MATLABW_MEX_MEX_HPP
 #define MATLABW_MEX_MEX_HPP
 
+#include "ArrayPool.hpp"
+#include "Dispatcher.hpp"
+#include "FunctionHandle.hpp"
+#include "HandleRegistry.hpp"
+#include "Signature.hpp"
+#include "atExit.hpp"
+#include "cancellation.hpp"
 #include "eval.hpp"
 #include "io.hpp"
 #include "memory.hpp"
+#include "parallel.hpp"
 #include "variable.hpp"
 
 #endif /* MATLABW_MEX_MEX_HPP */
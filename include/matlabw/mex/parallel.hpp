@@ -0,0 +1,100 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MEX_PARALLEL_HPP
+#define MATLABW_MEX_PARALLEL_HPP
+
+#include "detail/include.hpp"
+
+#include "atExit.hpp"
+#include "eval.hpp"
+
+namespace matlabw::mex
+{
+  /**
+   * @brief Gets MATLAB's maximum number of computational threads.
+   * @return The number of threads, hardware concurrency if the query fails.
+   */
+  [[nodiscard]] inline std::size_t getComputationalThreadCount()
+  {
+    try
+    {
+      mx::Array result{};
+
+      call(mx::Span<mx::Array>{&result, 1}, {}, "maxNumCompThreads");
+
+      if (result.isDouble() && !result.isComplex() && result.isScalar())
+      {
+        return std::max(std::size_t{1}, static_cast<std::size_t>(*static_cast<const double*>(result.getData())));
+      }
+    }
+    catch (const mx::Exception&)
+    {
+      // fall back to the hardware concurrency
+    }
+
+    return std::max(std::size_t{1}, static_cast<std::size_t>(std::thread::hardware_concurrency()));
+  }
+
+  /**
+   * @brief Destroys the shared thread pool and unlocks the MEX function so that it can be cleared. The next use of
+   *        a parallel algorithm creates a new pool.
+   */
+  inline void shutdownThreadPool()
+  {
+    mx::checkThread("matlabw:mex:shutdownThreadPool");
+
+    if (mx::detail::getThreadPoolStorage())
+    {
+      mx::resetThreadPool();
+      mexUnlock();
+    }
+  }
+
+  namespace detail
+  {
+    /// @brief Keeps the MEX function loaded while the shared thread pool exists and destroys it on exit.
+    inline void onThreadPoolCreated()
+    {
+      static const bool registered = (atExit([]{ mx::resetThreadPool(); }), true);
+
+      static_cast<void>(registered);
+
+      mexLock();
+    }
+
+    /// @brief Installs the MEX hooks of the shared thread pool when the MEX file is loaded.
+    inline const bool threadPoolHooksInstalled = []
+    {
+      auto& hooks = mx::detail::getThreadPoolHooks();
+
+      hooks.getThreadCount = []() -> std::size_t { return getComputationalThreadCount(); };
+      hooks.onCreate       = &onThreadPoolCreated;
+
+      return true;
+    }();
+  } // namespace detail
+} // namespace matlabw::mex
+
+#endif /* MATLABW_MEX_PARALLEL_HPP */
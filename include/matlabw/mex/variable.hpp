@@ -65,6 +65,8 @@ namespace matlabw::mex
    */
   inline void putVariable(Workspace workspace, const char* name, mx::ArrayCref value)
   {
+    mx::checkThread("matlabw:mex:putVariable");
+
     if (name == nullptr)
     {
       throw mx::Exception{"invalid variable name"};
@@ -97,6 +99,8 @@ namespace matlabw::mex
    */
   [[nodiscard]] inline std::optional<mx::ArrayCref> getVariableCref(Workspace workspace, const char* name)
   {
+    mx::checkThread("matlabw:mex:getVariableCref");
+
     if (name == nullptr)
     {
       throw mx::Exception{"invalid variable name"};
@@ -133,6 +137,8 @@ namespace matlabw::mex
    */
   [[nodiscard]] inline std::optional<mx::Array> getVariable(Workspace workspace, const char* name)
   {
+    mx::checkThread("matlabw:mex:getVariable");
+
     if (name == nullptr)
     {
       throw mx::Exception{"invalid variable name"};
@@ -0,0 +1,280 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_ARENA_HPP
+#define MATLABW_MX_ARENA_HPP
+
+#include "detail/include.hpp"
+
+#include "memory.hpp"
+
+namespace matlabw::mx
+{
+  /**
+   * @brief Bump allocator that takes large blocks from mxMalloc and hands out memory by advancing a pointer.
+   *        Individual deallocations are no-ops, all memory is returned at once by release() or the destructor.
+   */
+  class Arena : public std::pmr::memory_resource
+  {
+    public:
+      /// @brief Default size of the first block in bytes.
+      static constexpr std::size_t defaultBlockSize{64 * 1024};
+
+      /// @brief Default constructor. No memory is allocated until the first request.
+      Arena() noexcept = default;
+
+      /**
+       * @brief Constructor.
+       * @param initialBlockSize The size of the first block in bytes. Subsequent blocks grow geometrically.
+       */
+      explicit Arena(std::size_t initialBlockSize) noexcept
+      : mNextBlockSize{std::max(initialBlockSize, sizeof(BlockHeader))}
+      {}
+
+      /// @brief Explicitly deleted copy constructor.
+      Arena(const Arena&) = delete;
+
+      /// @brief Explicitly deleted move constructor.
+      Arena(Arena&&) = delete;
+
+      /// @brief Destructor. Releases all blocks.
+      ~Arena() noexcept override
+      {
+        release();
+      }
+
+      /// @brief Explicitly deleted copy assignment operator.
+      Arena& operator=(const Arena&) = delete;
+
+      /// @brief Explicitly deleted move assignment operator.
+      Arena& operator=(Arena&&) = delete;
+
+      /**
+       * @brief Releases all memory allocated by the arena. All pointers obtained from the arena become invalid.
+       */
+      void release() noexcept
+      {
+        while (mHead != nullptr)
+        {
+          BlockHeader* next = mHead->next;
+          mx::free(mHead);
+          mHead = next;
+        }
+
+        mCurrent  = nullptr;
+        mEnd      = nullptr;
+        mCapacity = 0;
+      }
+
+      /**
+       * @brief Gets the total size of the blocks owned by the arena.
+       * @return The size in bytes.
+       */
+      [[nodiscard]] std::size_t getCapacity() const noexcept
+      {
+        return mCapacity;
+      }
+    private:
+      /// @brief Header stored at the beginning of each block.
+      struct BlockHeader
+      {
+        BlockHeader* next; ///< The previously allocated block.
+      };
+
+      /**
+       * @brief Allocates memory from the arena.
+       * @param bytes The size of the memory in bytes.
+       * @param alignment The alignment of the memory.
+       * @return A pointer to the allocated memory.
+       */
+      void* do_allocate(std::size_t bytes, std::size_t alignment) override
+      {
+        if (void* ptr = bump(bytes, alignment); ptr != nullptr)
+        {
+          return ptr;
+        }
+
+        allocateBlock(bytes, alignment);
+
+        return bump(bytes, alignment);
+      }
+
+      /// @brief Deallocation is a no-op, memory is reclaimed by release().
+      void do_deallocate(void*, std::size_t, std::size_t) noexcept override {}
+
+      /**
+       * @brief Checks if two memory resources are equal.
+       * @param other The other memory resource.
+       * @return True if other is this arena, false otherwise.
+       */
+      [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+      {
+        return this == &other;
+      }
+
+      /**
+       * @brief Tries to allocate memory from the current block.
+       * @param bytes The size of the memory in bytes.
+       * @param alignment The alignment of the memory.
+       * @return A pointer to the allocated memory or nullptr if the current block is exhausted.
+       */
+      [[nodiscard]] void* bump(std::size_t bytes, std::size_t alignment) noexcept
+      {
+        if (mCurrent == nullptr)
+        {
+          return nullptr;
+        }
+
+        const auto address = reinterpret_cast<std::uintptr_t>(mCurrent);
+        const auto aligned = (address + (alignment - 1)) & ~static_cast<std::uintptr_t>(alignment - 1);
+        const auto end     = reinterpret_cast<std::uintptr_t>(mEnd);
+
+        if (aligned > end || end - aligned < bytes)
+        {
+          return nullptr;
+        }
+
+        mCurrent = reinterpret_cast<std::byte*>(aligned + bytes);
+
+        return reinterpret_cast<void*>(aligned);
+      }
+
+      /**
+       * @brief Allocates a new block large enough to hold the request.
+       * @param bytes The size of the request in bytes.
+       * @param alignment The alignment of the request.
+       */
+      void allocateBlock(std::size_t bytes, std::size_t alignment)
+      {
+        constexpr std::size_t maxSize = std::numeric_limits<std::size_t>::max();
+
+        if (bytes > maxSize - sizeof(BlockHeader) - alignment)
+        {
+          throw std::bad_alloc{};
+        }
+
+        const std::size_t size = std::max(mNextBlockSize, sizeof(BlockHeader) + alignment + bytes);
+
+        auto block = static_cast<BlockHeader*>(mx::malloc(size));
+
+        if (block == nullptr)
+        {
+          throw std::bad_alloc{};
+        }
+
+        block->next = mHead;
+        mHead       = block;
+        mCurrent    = reinterpret_cast<std::byte*>(block + 1);
+        mEnd        = reinterpret_cast<std::byte*>(block) + size;
+        mCapacity  += size;
+
+        mNextBlockSize = (size <= maxSize / 2) ? size * 2 : size;
+      }
+
+      BlockHeader* mHead{};                          ///< Most recently allocated block.
+      std::byte*   mCurrent{};                       ///< Next free byte in the current block.
+      std::byte*   mEnd{};                           ///< End of the current block.
+      std::size_t  mCapacity{};                      ///< Total size of the owned blocks.
+      std::size_t  mNextBlockSize{defaultBlockSize}; ///< Size of the next block.
+  };
+
+  /**
+   * @brief Allocator for use with std containers that draws memory from an Arena.
+   * @tparam T The type of the allocated memory.
+   */
+  template<typename T>
+  class ArenaAllocator
+  {
+    template<typename U>
+    friend class ArenaAllocator;
+
+    public:
+      using value_type = T; ///< The type of the allocated memory.
+
+      /**
+       * @brief Constructor.
+       * @param arena The arena to allocate from. Must outlive the allocator and all allocated memory.
+       */
+      ArenaAllocator(Arena& arena) noexcept
+      : mArena{&arena}
+      {}
+
+      /**
+       * @brief Copy constructor.
+       * @tparam U The type of the allocated memory.
+       * @param other The allocator to copy.
+       */
+      template<typename U>
+      ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : mArena{other.mArena}
+      {}
+
+      /**
+       * @brief Allocates memory.
+       * @param n The number of elements to allocate.
+       * @return A pointer to the allocated memory.
+       */
+      [[nodiscard]] T* allocate(std::size_t n)
+      {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+          throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(mArena->allocate(n * sizeof(T), alignof(T)));
+      }
+
+      /**
+       * @brief Deallocates memory. This is a no-op, memory is reclaimed when the arena is released.
+       * @param ptr A pointer to the allocated memory.
+       * @param n The number of elements to deallocate.
+       */
+      void deallocate(T*, std::size_t) noexcept {}
+
+      /**
+       * @brief Gets the arena the allocator draws from.
+       * @return The arena.
+       */
+      [[nodiscard]] Arena& getArena() const noexcept
+      {
+        return *mArena;
+      }
+
+      /**
+       * @brief Compares two allocators.
+       * @tparam U The type of the other allocator.
+       * @param other The other allocator.
+       * @return True if both allocators draw from the same arena, false otherwise.
+       */
+      template<typename U>
+      [[nodiscard]] bool operator==(const ArenaAllocator<U>& other) const noexcept
+      {
+        return mArena == other.mArena;
+      }
+    private:
+      Arena* mArena; ///< The arena to allocate from.
+  };
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_ARENA_HPP */
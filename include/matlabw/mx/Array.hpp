@@ -30,6 +30,7 @@
 #include "ArrayRef.hpp"
 #include "common.hpp"
 #include "Exception.hpp"
+#include "threadCheck.hpp"
 #include "typeTraits.hpp"
 
 namespace matlabw::mx
@@ -632,6 +633,8 @@ namespace matlabw::mx
        */
       void checkValid(const char* id) const
       {
+        checkThread(id);
+
         if (!isValid())
         {
           throw Exception{id, "accessing invalid array"};
@@ -29,6 +29,7 @@
 
 #include "common.hpp"
 #include "Exception.hpp"
+#include "threadCheck.hpp"
 #include "typeTraits.hpp"
 
 namespace matlabw::mx
@@ -76,6 +77,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getRank() const
       {
+        checkThread("matlabw:mx:ArrayRef:getRank");
         return mxGetNumberOfDimensions(mArray);
       }
 
@@ -85,6 +87,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] View<std::size_t> getDims() const
       {
+        checkThread("matlabw:mx:ArrayRef:getDims");
         return View<std::size_t>{mxGetDimensions(mArray), getRank()};
       }
 
@@ -94,6 +97,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getDimM() const
       {
+        checkThread("matlabw:mx:ArrayRef:getDimM");
         return mxGetM(mArray);
       }
 
@@ -103,6 +107,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getDimN() const
       {
+        checkThread("matlabw:mx:ArrayRef:getDimN");
         return mxGetN(mArray);
       }
 
@@ -112,6 +117,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getSize() const
       {
+        checkThread("matlabw:mx:ArrayRef:getSize");
         return mxGetNumberOfElements(mArray);
       }
 
@@ -121,6 +127,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getSizeOfElement() const
       {
+        checkThread("matlabw:mx:ArrayRef:getSizeOfElement");
         return mxGetElementSize(mArray);
       }
 
@@ -130,6 +137,7 @@ namespace matlabw::mx
        */
       void resize(View<std::size_t> dims) const
       {
+        checkThread("matlabw:mx:ArrayRef:resize");
         if (mxSetDimensions(mArray, dims.data(), dims.size()))
         {
           throw Exception{"failed to resize array"};
@@ -153,6 +161,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isGpuArray() const
       {
+        checkThread("matlabw:mx:ArrayRef:isGpuArray");
         return mxIsGPUArray(mArray);
       }
 #   endif
@@ -163,6 +172,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isNumeric() const
       {
+        checkThread("matlabw:mx:ArrayRef:isNumeric");
         return mxIsNumeric(mArray);
       }
 
@@ -172,6 +182,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isComplex() const
       {
+        checkThread("matlabw:mx:ArrayRef:isComplex");
         return mxIsComplex(mArray);
       }
 
@@ -181,6 +192,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isEmpty() const
       {
+        checkThread("matlabw:mx:ArrayRef:isEmpty");
         return mxIsEmpty(mArray);
       }
 
@@ -190,6 +202,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isScalar() const
       {
+        checkThread("matlabw:mx:ArrayRef:isScalar");
         return mxIsScalar(mArray);
       }
 
@@ -199,6 +212,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isDouble() const
       {
+        checkThread("matlabw:mx:ArrayRef:isDouble");
         return mxIsDouble(mArray);
       }
 
@@ -208,6 +222,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isSingle() const
       {
+        checkThread("matlabw:mx:ArrayRef:isSingle");
         return mxIsSingle(mArray);
       }
 
@@ -217,6 +232,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isInt8() const
       {
+        checkThread("matlabw:mx:ArrayRef:isInt8");
         return mxIsInt8(mArray);
       }
 
@@ -226,6 +242,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isUint8() const
       {
+        checkThread("matlabw:mx:ArrayRef:isUint8");
         return mxIsUint8(mArray);
       }
 
@@ -235,6 +252,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isInt16() const
       {
+        checkThread("matlabw:mx:ArrayRef:isInt16");
         return mxIsInt16(mArray);
       }
 
@@ -244,6 +262,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isUint16() const
       {
+        checkThread("matlabw:mx:ArrayRef:isUint16");
         return mxIsUint16(mArray);
       }
 
@@ -253,6 +272,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isInt32() const
       {
+        checkThread("matlabw:mx:ArrayRef:isInt32");
         return mxIsInt32(mArray);
       }
 
@@ -262,6 +282,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isUint32() const
       {
+        checkThread("matlabw:mx:ArrayRef:isUint32");
         return mxIsUint32(mArray);
       }
 
@@ -271,6 +292,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isInt64() const
       {
+        checkThread("matlabw:mx:ArrayRef:isInt64");
         return mxIsInt64(mArray);
       }
 
@@ -280,6 +302,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isUint64() const
       {
+        checkThread("matlabw:mx:ArrayRef:isUint64");
         return mxIsUint64(mArray);
       }
 
@@ -289,6 +312,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isSparse() const
       {
+        checkThread("matlabw:mx:ArrayRef:isSparse");
         return mxIsSparse(mArray);
       }
 
@@ -298,6 +322,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isChar() const
       {
+        checkThread("matlabw:mx:ArrayRef:isChar");
         return mxIsChar(mArray);
       }
 
@@ -307,6 +332,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isLogical() const
       {
+        checkThread("matlabw:mx:ArrayRef:isLogical");
         return mxIsLogical(mArray);
       }
 
@@ -316,6 +342,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isLogicalScalar() const
       {
+        checkThread("matlabw:mx:ArrayRef:isLogicalScalar");
         return mxIsLogicalScalar(mArray);
       }
 
@@ -325,6 +352,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isLogicalScalarTrue() const
       {
+        checkThread("matlabw:mx:ArrayRef:isLogicalScalarTrue");
         return mxIsLogicalScalarTrue(mArray);
       }
 
@@ -335,6 +363,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isClass(const char* name) const
       {
+        checkThread("matlabw:mx:ArrayRef:isClass");
         if (name == nullptr)
         {
           throw Exception{"invalid class name"};
@@ -359,6 +388,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isStruct() const
       {
+        checkThread("matlabw:mx:ArrayRef:isStruct");
         return mxIsStruct(mArray);
       }
 
@@ -368,6 +398,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isCell() const
       {
+        checkThread("matlabw:mx:ArrayRef:isCell");
         return mxIsCell(mArray);
       }
 
@@ -377,6 +408,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] ClassId getClassId() const
       {
+        checkThread("matlabw:mx:ArrayRef:getClassId");
         return static_cast<ClassId>(mxGetClassID(mArray));
       }
 
@@ -386,6 +418,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] const char* getClassName() const
       {
+        checkThread("matlabw:mx:ArrayRef:getClassName");
         return mxGetClassName(mArray);
       }
 
@@ -395,6 +428,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] void* getData() const
       {
+        checkThread("matlabw:mx:ArrayRef:getData");
         return mxGetData(mArray);
       }
 
@@ -499,6 +533,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getRank() const
       {
+        checkThread("matlabw:mx:ArrayCref:getRank");
         return mxGetNumberOfDimensions(mArray);
       }
 
@@ -508,6 +543,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] View<std::size_t> getDims() const
       {
+        checkThread("matlabw:mx:ArrayCref:getDims");
         return View<std::size_t>{mxGetDimensions(mArray), getRank()};
       }
 
@@ -517,6 +553,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getDimM() const
       {
+        checkThread("matlabw:mx:ArrayCref:getDimM");
         return mxGetM(mArray);
       }
 
@@ -526,6 +563,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getDimN() const
       {
+        checkThread("matlabw:mx:ArrayCref:getDimN");
         return mxGetN(mArray);
       }
 
@@ -535,6 +573,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getSize() const
       {
+        checkThread("matlabw:mx:ArrayCref:getSize");
         return mxGetNumberOfElements(mArray);
       }
 
@@ -544,6 +583,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getSizeOfElement() const
       {
+        checkThread("matlabw:mx:ArrayCref:getSizeOfElement");
         return mxGetElementSize(mArray);
       }
 
@@ -554,6 +594,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isGpuArray() const
       {
+        checkThread("matlabw:mx:ArrayCref:isGpuArray");
         return mxIsGPUArray(mArray);
       }
 #   endif
@@ -564,6 +605,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isNumeric() const
       {
+        checkThread("matlabw:mx:ArrayCref:isNumeric");
         return mxIsNumeric(mArray);
       }
 
@@ -573,6 +615,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isComplex() const
       {
+        checkThread("matlabw:mx:ArrayCref:isComplex");
         return mxIsComplex(mArray);
       }
 
@@ -582,6 +625,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isEmpty() const
       {
+        checkThread("matlabw:mx:ArrayCref:isEmpty");
         return mxIsEmpty(mArray);
       }
 
@@ -591,6 +635,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isScalar() const
       {
+        checkThread("matlabw:mx:ArrayCref:isScalar");
         return mxIsScalar(mArray);
       }
 
@@ -600,6 +645,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isDouble() const
       {
+        checkThread("matlabw:mx:ArrayCref:isDouble");
         return mxIsDouble(mArray);
       }
 
@@ -609,6 +655,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isSingle() const
       {
+        checkThread("matlabw:mx:ArrayCref:isSingle");
         return mxIsSingle(mArray);
       }
 
@@ -618,6 +665,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isInt8() const
       {
+        checkThread("matlabw:mx:ArrayCref:isInt8");
         return mxIsInt8(mArray);
       }
 
@@ -627,6 +675,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isUint8() const
       {
+        checkThread("matlabw:mx:ArrayCref:isUint8");
         return mxIsUint8(mArray);
       }
 
@@ -636,6 +685,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isInt16() const
       {
+        checkThread("matlabw:mx:ArrayCref:isInt16");
         return mxIsInt16(mArray);
       }
 
@@ -645,6 +695,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isUint16() const
       {
+        checkThread("matlabw:mx:ArrayCref:isUint16");
         return mxIsUint16(mArray);
       }
 
@@ -654,6 +705,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isInt32() const
       {
+        checkThread("matlabw:mx:ArrayCref:isInt32");
         return mxIsInt32(mArray);
       }
 
@@ -663,6 +715,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isUint32() const
       {
+        checkThread("matlabw:mx:ArrayCref:isUint32");
         return mxIsUint32(mArray);
       }
 
@@ -672,6 +725,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isInt64() const
       {
+        checkThread("matlabw:mx:ArrayCref:isInt64");
         return mxIsInt64(mArray);
       }
 
@@ -681,6 +735,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isUint64() const
       {
+        checkThread("matlabw:mx:ArrayCref:isUint64");
         return mxIsUint64(mArray);
       }
 
@@ -690,6 +745,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isSparse() const
       {
+        checkThread("matlabw:mx:ArrayCref:isSparse");
         return mxIsSparse(mArray);
       }
 
@@ -699,6 +755,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isChar() const
       {
+        checkThread("matlabw:mx:ArrayCref:isChar");
         return mxIsChar(mArray);
       }
 
@@ -708,6 +765,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isLogical() const
       {
+        checkThread("matlabw:mx:ArrayCref:isLogical");
         return mxIsLogical(mArray);
       }
 
@@ -717,6 +775,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isLogicalScalar() const
       {
+        checkThread("matlabw:mx:ArrayCref:isLogicalScalar");
         return mxIsLogicalScalar(mArray);
       }
 
@@ -726,6 +785,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isLogicalScalarTrue() const
       {
+        checkThread("matlabw:mx:ArrayCref:isLogicalScalarTrue");
         return mxIsLogicalScalarTrue(mArray);
       }
 
@@ -736,6 +796,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isClass(const char* name) const
       {
+        checkThread("matlabw:mx:ArrayCref:isClass");
         if (name == nullptr)
         {
           throw Exception{"invalid class name"};
@@ -760,6 +821,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isStruct() const
       {
+        checkThread("matlabw:mx:ArrayCref:isStruct");
         return mxIsStruct(mArray);
       }
 
@@ -769,6 +831,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] bool isCell() const
       {
+        checkThread("matlabw:mx:ArrayCref:isCell");
         return mxIsCell(mArray);
       }
 
@@ -778,6 +841,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] ClassId getClassId() const
       {
+        checkThread("matlabw:mx:ArrayCref:getClassId");
         return static_cast<ClassId>(mxGetClassID(mArray));
       }
 
@@ -787,6 +851,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] const char* getClassName() const
       {
+        checkThread("matlabw:mx:ArrayCref:getClassName");
         return mxGetClassName(mArray);
       }
 
@@ -796,6 +861,7 @@ namespace matlabw::mx
        */
       [[nodiscard]] const void* getData() const
       {
+        checkThread("matlabw:mx:ArrayCref:getData");
         return mxGetData(mArray);
       }
 
@@ -846,6 +912,8 @@ namespace matlabw::mx
    */
   [[nodiscard]] inline std::size_t calcSingleSubscript(const ArrayCref array, View<std::size_t> subs)
   {
+    checkThread("matlabw:mx:calcSingleSubscript");
+
     return mxCalcSingleSubscript(array.get(), subs.size(), subs.data());
   }
 } // namespace matlabw::mx
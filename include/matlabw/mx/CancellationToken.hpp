@@ -0,0 +1,278 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_CANCELLATION_TOKEN_HPP
+#define MATLABW_MX_CANCELLATION_TOKEN_HPP
+
+#include "detail/include.hpp"
+
+#include "Exception.hpp"
+#include "threadCheck.hpp"
+
+namespace matlabw::mx
+{
+  /**
+   * @brief Cooperative cancellation flag shared by a long-running kernel and its parallel tasks. Workers call poll()
+   *        or throwIfCancelled() every getCheckInterval() iterations. Cancellation is requested by cancel(), by an
+   *        expired deadline or by an interrupt source. The sources are polled on the MATLAB thread only and at most
+   *        once per source interval, so they may call into the MATLAB API.
+   */
+  class CancellationToken
+  {
+    public:
+      /// @brief Clock measuring the deadline and the source interval.
+      using Clock = std::chrono::steady_clock;
+
+      /// @brief Interrupt source, returns true to request cancellation.
+      using Source = std::function<bool()>;
+
+      /// @brief Default number of loop iterations between two polls.
+      static constexpr std::size_t defaultCheckInterval{1024};
+
+      /// @brief Default minimum time between two polls of the interrupt sources.
+      static constexpr Clock::duration defaultSourceInterval{std::chrono::milliseconds{100}};
+
+      /// @brief Default constructor.
+      CancellationToken() = default;
+
+      /**
+       * @brief Constructor.
+       * @param checkInterval The number of loop iterations between two polls.
+       */
+      explicit CancellationToken(std::size_t checkInterval)
+      : mCheckInterval{std::max(checkInterval, std::size_t{1})}
+      {}
+
+      /// @brief Explicitly deleted copy constructor.
+      CancellationToken(const CancellationToken&) = delete;
+
+      /// @brief Explicitly deleted move constructor.
+      CancellationToken(CancellationToken&&) = delete;
+
+      /// @brief Destructor.
+      ~CancellationToken() = default;
+
+      /// @brief Explicitly deleted copy assignment operator.
+      CancellationToken& operator=(const CancellationToken&) = delete;
+
+      /// @brief Explicitly deleted move assignment operator.
+      CancellationToken& operator=(CancellationToken&&) = delete;
+
+      /**
+       * @brief Gets the number of loop iterations between two polls.
+       * @return The number of iterations.
+       */
+      [[nodiscard]] std::size_t getCheckInterval() const noexcept
+      {
+        return mCheckInterval;
+      }
+
+      /**
+       * @brief Sets the deadline after which the token is cancelled.
+       * @param deadline The deadline.
+       */
+      void setDeadline(Clock::time_point deadline) noexcept
+      {
+        mDeadline.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief Sets the deadline relative to now.
+       * @param timeout The time after which the token is cancelled.
+       */
+      void setTimeout(Clock::duration timeout) noexcept
+      {
+        setDeadline(Clock::now() + timeout);
+      }
+
+      /**
+       * @brief Adds an interrupt source.
+       * @param source The source, called on the MATLAB thread only.
+       */
+      void addSource(Source source)
+      {
+        if (!source)
+        {
+          throw Exception{"matlabw:mx:CancellationToken:addSource", "invalid source"};
+        }
+
+        std::lock_guard lock{mSourceMutex};
+        mSources.push_back(std::move(source));
+        mHasSources.store(true, std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief Sets the minimum time between two polls of the interrupt sources.
+       * @param interval The interval.
+       */
+      void setSourceInterval(Clock::duration interval)
+      {
+        std::lock_guard lock{mSourceMutex};
+        mSourceInterval = interval;
+      }
+
+      /// @brief Requests cancellation. May be called from any thread.
+      void cancel() noexcept
+      {
+        mCancelled.store(true, std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief Checks the cancellation flag only, a single atomic load.
+       * @return True if cancellation has been requested.
+       */
+      [[nodiscard]] bool isCancelled() const noexcept
+      {
+        return mCancelled.load(std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief Checks the flag, the deadline and, on the MATLAB thread, the interrupt sources.
+       * @return True if cancellation has been requested.
+       */
+      bool poll()
+      {
+        if (isCancelled())
+        {
+          return true;
+        }
+
+        const Clock::rep deadline = mDeadline.load(std::memory_order_relaxed);
+
+        if (deadline == noDeadline && !mHasSources.load(std::memory_order_relaxed))
+        {
+          return false;
+        }
+
+        const Clock::time_point now = Clock::now();
+
+        if (now.time_since_epoch().count() >= deadline)
+        {
+          cancel();
+        }
+        else if (mHasSources.load(std::memory_order_relaxed) && isMatlabThread())
+        {
+          pollSources(now);
+        }
+
+        return isCancelled();
+      }
+
+      /// @brief Polls the token and throws an exception if cancellation has been requested.
+      void throwIfCancelled()
+      {
+        if (poll()) [[unlikely]]
+        {
+          throw Exception{"matlabw:mx:CancellationToken:cancelled", "operation cancelled"};
+        }
+      }
+
+      /// @brief Clears the cancellation flag and the deadline, the sources are kept.
+      void reset() noexcept
+      {
+        mCancelled.store(false, std::memory_order_relaxed);
+        mDeadline.store(noDeadline, std::memory_order_relaxed);
+      }
+    private:
+      /// @brief Deadline value meaning no deadline.
+      static constexpr Clock::rep noDeadline{std::numeric_limits<Clock::rep>::max()};
+
+      /**
+       * @brief Polls the interrupt sources if the source interval has elapsed. Skipped if another thread is polling.
+       * @param now The current time.
+       */
+      void pollSources(Clock::time_point now)
+      {
+        std::unique_lock lock{mSourceMutex, std::try_to_lock};
+
+        if (!lock.owns_lock() || now < mNextSourcePoll)
+        {
+          return;
+        }
+
+        mNextSourcePoll = now + mSourceInterval;
+
+        for (const Source& source : mSources)
+        {
+          if (source())
+          {
+            cancel();
+            break;
+          }
+        }
+      }
+
+      std::atomic<bool>       mCancelled{};                           ///< The cancellation flag.
+      std::atomic<Clock::rep> mDeadline{noDeadline};                  ///< The deadline in clock ticks.
+      std::atomic<bool>       mHasSources{};                          ///< Set when a source has been added.
+      std::size_t             mCheckInterval{defaultCheckInterval};   ///< Loop iterations between two polls.
+      std::mutex              mSourceMutex{};                         ///< Protects the sources.
+      std::vector<Source>     mSources{};                             ///< The interrupt sources.
+      Clock::duration         mSourceInterval{defaultSourceInterval}; ///< Minimum time between two source polls.
+      Clock::time_point       mNextSourcePoll{};                      ///< Earliest time of the next source poll.
+  };
+
+  /**
+   * @brief Creates an interrupt source that requests cancellation once the given file exists, e.g. after
+   *        `touch stop` from a shell on the cluster node.
+   * @param path The path of the file.
+   * @return The interrupt source.
+   */
+  [[nodiscard]] inline CancellationToken::Source makeFileCancellationSource(std::filesystem::path path)
+  {
+    return [path = std::move(path)]
+    {
+      std::error_code error{};
+
+      return std::filesystem::exists(path, error);
+    };
+  }
+
+  namespace detail
+  {
+    /**
+     * @brief Calls fn(begin, end) for consecutive blocks of at most token.getCheckInterval() elements of the range
+     *        [begin, end) and polls the token before each block.
+     * @tparam Fn The callable type.
+     * @param begin The first index.
+     * @param end The index past the last one.
+     * @param token The cancellation token.
+     * @param fn The callable.
+     */
+    template<typename Fn>
+    void forEachCancellableBlock(std::size_t begin, std::size_t end, CancellationToken& token, Fn&& fn)
+    {
+      const std::size_t interval = token.getCheckInterval();
+
+      for (std::size_t blockBegin = begin; blockBegin < end; blockBegin += std::min(interval, end - blockBegin))
+      {
+        token.throwIfCancelled();
+
+        fn(blockBegin, blockBegin + std::min(interval, end - blockBegin));
+      }
+    }
+  } // namespace detail
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_CANCELLATION_TOKEN_HPP */
@@ -32,8 +32,111 @@
 
 namespace matlabw::mx
 {
+namespace detail
+{
+  /**
+   * @brief Gets the counter of cell elements handed over to a cell array without duplication.
+   * @return Reference to the counter.
+   */
+  [[nodiscard]] inline std::atomic<std::size_t>& getAvoidedDuplicateCounter() noexcept
+  {
+    static std::atomic<std::size_t> counter{};
+
+    return counter;
+  }
+} // namespace detail
+
+  /**
+   * @brief Gets the number of cell elements moved into cell arrays by CellArray::set, CellArray::emplace and
+   *        makeCellArray(std::vector<Array>&&), i.e. the number of mxDuplicateArray calls avoided.
+   * @return Number of avoided duplicates.
+   */
+  [[nodiscard]] inline std::size_t getAvoidedDuplicateCount() noexcept
+  {
+    return detail::getAvoidedDuplicateCounter().load(std::memory_order_relaxed);
+  }
+
   /// @brief CellArray class
-  using CellArray = TypedArray<Cell>;
+  class CellArray : public TypedArray<Cell>
+  {
+    public:
+      /// @brief Inherit constructors from TypedArray<Cell>
+      using TypedArray<Cell>::TypedArray;
+
+      /**
+       * @brief Copy constructor
+       * @param other Other array
+       */
+      explicit CellArray(const CellArray& other) = default;
+
+      /**
+       * @brief Move constructor, the array is taken over without duplication
+       * @param other Other array
+       */
+      CellArray(CellArray&& other) noexcept = default;
+
+      /// @brief Default destructor
+      ~CellArray() = default;
+
+      /// @brief Use the TypedArray<Cell>::operator=
+      using TypedArray<Cell>::operator=;
+
+      /**
+       * @brief Copy assignment operator
+       * @param other Other array
+       * @return Reference to this array
+       */
+      CellArray& operator=(const CellArray& other) = default;
+
+      /**
+       * @brief Move assignment operator, the array is taken over without duplication
+       * @param other Other array
+       * @return Reference to this array
+       */
+      CellArray& operator=(CellArray&& other) noexcept = default;
+
+      /**
+       * @brief Sets the element of the cell array. The value is handed over to the cell array without a copy, the
+       *        previous element is destroyed.
+       * @param i Index
+       * @param value The value, it is left invalid
+       */
+      void set(std::size_t i, Array&& value)
+      {
+        emplace(i, value.release());
+      }
+
+      /**
+       * @brief Sets the element of the cell array taking ownership of an mxArray, the previous element is destroyed.
+       * @param i Index
+       * @param array mxArray pointer (rvalue reference)
+       * @return Reference to the element
+       */
+      ArrayRef emplace(std::size_t i, mxArray*&& array)
+      {
+        // take the ownership first so that the array is destroyed if the checks throw
+        Array value{std::move(array)};
+
+        checkValid("matlabw:mx:CellArray:emplace");
+
+        if (i >= getSize())
+        {
+          throw Exception{"matlabw:mx:CellArray:emplace", "index out of range"};
+        }
+
+        if (!value.isValid())
+        {
+          throw Exception{"matlabw:mx:CellArray:emplace", "invalid value"};
+        }
+
+        mxDestroyArray(mxGetCell(get(), i));
+        mxSetCell(get(), i, value.release());
+
+        detail::getAvoidedDuplicateCounter().fetch_add(1, std::memory_order_relaxed);
+
+        return ArrayRef{mxGetCell(get(), i)};
+      }
+  };
 
   /**
    * @brief Create a cell array
@@ -62,6 +165,50 @@ namespace matlabw::mx
   {
     return makeCellArray({{m, n}});
   }
+
+  /**
+   * @brief Create a cell array taking over the values without copying them
+   * @param dims Dimensions of the cell array
+   * @param values Values in column-major order, their count must match the dimensions. The vector is left empty.
+   * @return CellArray
+   */
+  [[nodiscard]] inline CellArray makeCellArray(View<std::size_t> dims, std::vector<Array>&& values)
+  {
+    const std::size_t size = std::accumulate(dims.begin(), dims.end(), std::size_t{1}, std::multiplies<>{});
+
+    if (values.size() != size)
+    {
+      throw Exception{"matlabw:mx:makeCellArray", "number of values does not match the dimensions"};
+    }
+
+    if (std::any_of(values.begin(), values.end(), [](const Array& value) { return !value.isValid(); }))
+    {
+      throw Exception{"matlabw:mx:makeCellArray", "invalid value"};
+    }
+
+    CellArray array = makeCellArray(dims);
+
+    for (std::size_t i{}; i < size; ++i)
+    {
+      mxSetCell(array.get(), i, values[i].release());
+    }
+
+    values.clear();
+
+    detail::getAvoidedDuplicateCounter().fetch_add(size, std::memory_order_relaxed);
+
+    return array;
+  }
+
+  /**
+   * @brief Create a 1xN cell array taking over the values without copying them
+   * @param values Values, the vector is left empty
+   * @return CellArray
+   */
+  [[nodiscard]] inline CellArray makeCellArray(std::vector<Array>&& values)
+  {
+    return makeCellArray({{1, values.size()}}, std::move(values));
+  }
 } // namespace matlabw::mx
 
 #endif /* MATLABW_MX_CELL_ARRAY_HPP */
@@ -36,7 +36,7 @@ namespace matlabw::mx
    * @param array TypedArrayCref<char16_t>
    * @return std::string
    */
-  [[nodiscard]] std::string toAscii(TypedArrayCref<char16_t> array);
+  [[nodiscard]] inline std::string toAscii(TypedArrayCref<char16_t> array);
 
   /**
    * @brief Convert a char array to a std::string
@@ -151,29 +151,41 @@ namespace matlabw::mx
 
   /**
    * @brief Convert a char16_t array to a std::string
-   * @param array CharArrayCref
+   * @param array TypedArrayCref<char16_t>, a row vector or an empty array
    * @return std::string
    */
-  [[nodiscard]] inline std::string toAscii(CharArrayCref array)
+  [[nodiscard]] inline std::string toAscii(TypedArrayCref<char16_t> array)
   {
     static constexpr char id[]{"matlabw:mx:toAscii"};
 
-    if (array.isSingleString())
+    checkThread(id);
+
+    const std::size_t size = array.getSize();
+
+    if (size != 0 && (array.getRank() > 2 || array.getDimM() != 1))
     {
       throw Exception{id, "Input must be a single string.\n"};
     }
 
-    const std::size_t size = std::char_traits<char16_t>::length(array.getData());
-
     std::string str(size, '\0');
 
-    if (mxGetString(array.get(), str.data(), size + 1))
+    if (size != 0 && mxGetString(array.get(), str.data(), size + 1))
     {
       throw Exception{id, "Failed to convert char16_t array to string.\n"};
     }
 
     return str;
   }
+
+  /**
+   * @brief Convert a char16_t array to a std::string
+   * @param array CharArrayCref, a single string or an empty array
+   * @return std::string
+   */
+  [[nodiscard]] inline std::string toAscii(CharArrayCref array)
+  {
+    return toAscii(static_cast<const TypedArrayCref<char16_t>&>(array));
+  }
 } // namespace matlabw::mx
 
 #endif /* MATLABW_MX_CHAR_ARRAY_REF_HPP */
@@ -0,0 +1,352 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_FIELD_ACCESSOR_HPP
+#define MATLABW_MX_FIELD_ACCESSOR_HPP
+
+#include "detail/include.hpp"
+
+#include "Array.hpp"
+#include "FixedString.hpp"
+#include "StructArrayRef.hpp"
+#include "threadCheck.hpp"
+
+namespace matlabw::mx
+{
+  /**
+   * @brief Accessor of a set of fields of a structure array. The field names are resolved to field indices once, so
+   *        element-wise access in loops avoids the field name lookup and the field count check of
+   *        StructArrayRef::getField. Fields missing from the array are resolved to FieldIndex::invalid.
+   *
+   * The field names are either given at run time, or as template arguments, which lets getField<"name">(i) select the
+   * cached index at compile time, e.g.
+   * @code
+   *   FieldAccessor<StructArrayCref, "x", "y"> fields{array};
+   *
+   *   for (std::size_t i{}; i < array.getSize(); ++i)
+   *   {
+   *     auto x = fields.getField<"x">(i);
+   *   }
+   * @endcode
+   *
+   * The indices stay valid as long as no fields are added to or removed from the array, see isValid().
+   * @tparam StructRef The structure array reference type, StructArrayRef or StructArrayCref.
+   * @tparam names The field names. If empty, the field names are passed to the constructor.
+   */
+  template<typename StructRef, FixedString... names>
+  class FieldAccessor
+  {
+    static_assert(std::is_same_v<StructRef, StructArrayRef> || std::is_same_v<StructRef, StructArrayCref>,
+                  "StructRef must be StructArrayRef or StructArrayCref");
+
+    public:
+      /// @brief Whether the fields may be modified.
+      static constexpr bool isMutable = std::is_same_v<StructRef, StructArrayRef>;
+
+      /// @brief Whether the field names are given as template arguments.
+      static constexpr bool isStatic = (sizeof...(names) > 0);
+
+      /// @brief Field reference type.
+      using FieldRef = std::conditional_t<isMutable, ArrayRef, ArrayCref>;
+
+      /**
+       * @brief Constructor. Resolves the field names given as template arguments.
+       * @param array The structure array.
+       */
+      explicit FieldAccessor(StructRef array) requires (isStatic)
+      : mArray{array}, mFieldCount{array.getFieldCount()}
+      {
+        std::size_t k{};
+
+        ((mIndices[k++] = array.getFieldIndex(names.c_str())), ...);
+      }
+
+      /**
+       * @brief Constructor. Resolves the field names.
+       * @param array The structure array.
+       * @param fieldNames The null-terminated field names.
+       */
+      FieldAccessor(StructRef array, View<const char*> fieldNames) requires (!isStatic)
+      : mArray{array}, mFieldCount{array.getFieldCount()}
+      {
+        mNames.reserve(fieldNames.size());
+        mIndices.reserve(fieldNames.size());
+
+        for (const char* fieldName : fieldNames)
+        {
+          if (fieldName == nullptr)
+          {
+            throw Exception{"matlabw:mx:FieldAccessor:FieldAccessor", "invalid field name"};
+          }
+
+          mNames.emplace_back(fieldName);
+          mIndices.push_back(array.getFieldIndex(fieldName));
+        }
+      }
+
+      /**
+       * @brief Constructor. Resolves the field names.
+       * @param array The structure array.
+       * @param fieldNames The null-terminated field names.
+       */
+      FieldAccessor(StructRef array, std::initializer_list<const char*> fieldNames) requires (!isStatic)
+      : FieldAccessor{array, View<const char*>{fieldNames.begin(), fieldNames.size()}}
+      {}
+
+      /**
+       * @brief Gets the number of accessed fields.
+       * @return The number of accessed fields.
+       */
+      [[nodiscard]] std::size_t getSize() const noexcept
+      {
+        return mIndices.size();
+      }
+
+      /**
+       * @brief Gets the structure array.
+       * @return The structure array.
+       */
+      [[nodiscard]] StructRef getArray() const noexcept
+      {
+        return mArray;
+      }
+
+      /**
+       * @brief Gets the cached field index.
+       * @param k The position of the field name in the accessor.
+       * @return The field index, FieldIndex::invalid if the array has no such field.
+       */
+      [[nodiscard]] FieldIndex getFieldIndex(std::size_t k) const
+      {
+        if (k >= mIndices.size())
+        {
+          throw Exception{"matlabw:mx:FieldAccessor:getFieldIndex", "field position out of range"};
+        }
+
+        return mIndices[k];
+      }
+
+      /**
+       * @brief Gets the cached field index.
+       * @tparam name The field name.
+       * @return The field index, FieldIndex::invalid if the array has no such field.
+       */
+      template<FixedString name>
+      [[nodiscard]] FieldIndex getFieldIndex() const noexcept requires (isStatic)
+      {
+        return mIndices[getPosition<name>()];
+      }
+
+      /**
+       * @brief Gets a field.
+       * @param i The index of the structure.
+       * @param k The position of the field name in the accessor.
+       * @return The field or std::nullopt if the field is missing or unset.
+       */
+      [[nodiscard]] std::optional<FieldRef> getField(std::size_t i, std::size_t k) const
+      {
+        return getFieldAt(i, getFieldIndex(k));
+      }
+
+      /**
+       * @brief Gets a field.
+       * @tparam name The field name.
+       * @param i The index of the structure.
+       * @return The field or std::nullopt if the field is missing or unset.
+       */
+      template<FixedString name>
+      [[nodiscard]] std::optional<FieldRef> getField(std::size_t i = 0) const requires (isStatic)
+      {
+        return getFieldAt(i, getFieldIndex<name>());
+      }
+
+      /**
+       * @brief Sets a field. The previous value is destroyed.
+       * @param i The index of the structure.
+       * @param k The position of the field name in the accessor.
+       * @param value The value, it is duplicated.
+       */
+      void setField(std::size_t i, std::size_t k, ArrayCref value) requires (isMutable)
+      {
+        setFieldAt(i, getFieldIndex(k), Array{value});
+      }
+
+      /**
+       * @brief Sets a field. The previous value is destroyed.
+       * @param i The index of the structure.
+       * @param k The position of the field name in the accessor.
+       * @param value The value.
+       */
+      void setField(std::size_t i, std::size_t k, Array&& value) requires (isMutable)
+      {
+        setFieldAt(i, getFieldIndex(k), std::move(value));
+      }
+
+      /**
+       * @brief Sets a field. The previous value is destroyed.
+       * @tparam name The field name.
+       * @param i The index of the structure.
+       * @param value The value, it is duplicated.
+       */
+      template<FixedString name>
+      void setField(std::size_t i, ArrayCref value) requires (isStatic && isMutable)
+      {
+        setFieldAt(i, getFieldIndex<name>(), Array{value});
+      }
+
+      /**
+       * @brief Sets a field. The previous value is destroyed.
+       * @tparam name The field name.
+       * @param i The index of the structure.
+       * @param value The value.
+       */
+      template<FixedString name>
+      void setField(std::size_t i, Array&& value) requires (isStatic && isMutable)
+      {
+        setFieldAt(i, getFieldIndex<name>(), std::move(value));
+      }
+
+      /**
+       * @brief Checks if the cached field indices are still valid, i.e. no fields were added to or removed from the
+       *        array since the accessor was created.
+       * @return True if the cached indices are valid, false otherwise.
+       */
+      [[nodiscard]] bool isValid() const
+      {
+        if (mArray.getFieldCount() != mFieldCount)
+        {
+          return false;
+        }
+
+        for (std::size_t k{}; k < mIndices.size(); ++k)
+        {
+          if (mArray.getFieldIndex(getName(k)) != mIndices[k])
+          {
+            return false;
+          }
+        }
+
+        return true;
+      }
+    private:
+      /// @brief Field index storage type.
+      using Indices = std::conditional_t<isStatic, std::array<FieldIndex, sizeof...(names)>, std::vector<FieldIndex>>;
+
+      /// @brief Field name storage type, static names are not stored.
+      using Names = std::conditional_t<isStatic, std::array<std::string, 0>, std::vector<std::string>>;
+
+      /**
+       * @brief Gets the position of a field name given as template argument.
+       * @tparam name The field name.
+       * @return The position.
+       */
+      template<FixedString name>
+      [[nodiscard]] static consteval std::size_t getPosition() noexcept
+      {
+        constexpr std::size_t position = []
+        {
+          const std::array<std::string_view, sizeof...(names)> fieldNames{std::string_view{names}...};
+
+          return static_cast<std::size_t>(std::ranges::find(fieldNames, std::string_view{name}) - fieldNames.begin());
+        }();
+
+        static_assert(position < sizeof...(names), "field name is not accessed by this accessor");
+
+        return position;
+      }
+
+      /**
+       * @brief Gets a field name.
+       * @param k The position of the field name.
+       * @return The null-terminated field name.
+       */
+      [[nodiscard]] const char* getName(std::size_t k) const noexcept
+      {
+        if constexpr (isStatic)
+        {
+          static constexpr std::array<const char*, sizeof...(names)> fieldNames{names.c_str()...};
+
+          return fieldNames[k];
+        }
+        else
+        {
+          return mNames[k].c_str();
+        }
+      }
+
+      /**
+       * @brief Gets a field without checking the field count.
+       * @param i The index of the structure.
+       * @param fieldIndex The cached field index.
+       * @return The field or std::nullopt if the field is missing or unset.
+       */
+      [[nodiscard]] std::optional<FieldRef> getFieldAt(std::size_t i, FieldIndex fieldIndex) const
+      {
+        checkThread("matlabw:mx:FieldAccessor:getField");
+
+        if (fieldIndex == FieldIndex::invalid)
+        {
+          return std::nullopt;
+        }
+
+        mxArray* field = mxGetFieldByNumber(mArray.get(), i, static_cast<int>(fieldIndex));
+
+        if (field == nullptr)
+        {
+          return std::nullopt;
+        }
+
+        return FieldRef{field};
+      }
+
+      /**
+       * @brief Sets a field without checking the field count.
+       * @param i The index of the structure.
+       * @param fieldIndex The cached field index.
+       * @param value The value.
+       */
+      void setFieldAt(std::size_t i, FieldIndex fieldIndex, Array&& value)
+      {
+        checkThread("matlabw:mx:FieldAccessor:setField");
+
+        if (fieldIndex == FieldIndex::invalid)
+        {
+          throw Exception{"matlabw:mx:FieldAccessor:setField", "invalid field index"};
+        }
+
+        mxArray* array = mArray.get();
+        int      field = static_cast<int>(fieldIndex);
+
+        mxDestroyArray(mxGetFieldByNumber(array, i, field));
+        mxSetFieldByNumber(array, i, field, value.release());
+      }
+
+      StructRef   mArray;         ///< The structure array.
+      std::size_t mFieldCount{};  ///< The field count when the indices were resolved.
+      Indices     mIndices{};     ///< The cached field indices.
+      Names       mNames{};       ///< The field names given at run time.
+  };
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_FIELD_ACCESSOR_HPP */
@@ -0,0 +1,93 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_FIXED_STRING_HPP
+#define MATLABW_MX_FIXED_STRING_HPP
+
+#include "detail/include.hpp"
+
+namespace matlabw::mx
+{
+  /**
+   * @brief Null-terminated string usable as a template argument, e.g. getField<"name">().
+   * @tparam N The size of the string including the null terminator.
+   */
+  template<std::size_t N>
+  struct FixedString
+  {
+    static_assert(N > 0, "FixedString must hold at least the null terminator");
+
+    /**
+     * @brief Constructor from a string literal.
+     * @param str The string literal.
+     */
+    constexpr FixedString(const char (&str)[N]) noexcept
+    {
+      std::copy_n(str, N, chars);
+    }
+
+    /**
+     * @brief Gets the size of the string.
+     * @return The size of the string without the null terminator.
+     */
+    [[nodiscard]] static constexpr std::size_t size() noexcept
+    {
+      return N - 1;
+    }
+
+    /**
+     * @brief Gets the null-terminated string.
+     * @return The null-terminated string.
+     */
+    [[nodiscard]] constexpr const char* c_str() const noexcept
+    {
+      return chars;
+    }
+
+    /**
+     * @brief Converts the string to std::string_view.
+     * @return The string view.
+     */
+    [[nodiscard]] constexpr operator std::string_view() const noexcept
+    {
+      return std::string_view{chars, size()};
+    }
+
+    /**
+     * @brief Compares two strings.
+     * @tparam M The size of the other string.
+     * @param other The other string.
+     * @return True if the strings are equal, false otherwise.
+     */
+    template<std::size_t M>
+    [[nodiscard]] constexpr bool operator==(const FixedString<M>& other) const noexcept
+    {
+      return std::string_view{*this} == std::string_view{other};
+    }
+
+    char chars[N]{}; ///< The characters including the null terminator, public to keep the type structural.
+  };
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_FIXED_STRING_HPP */
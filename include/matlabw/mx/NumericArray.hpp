@@ -175,6 +175,41 @@ namespace matlabw::mx
     return makeUninitNumericArray<T>({{m, n}});
   }
 
+  /**
+   * @brief Creates a numeric array that takes ownership of a buffer allocated by mx::malloc or mx::calloc without
+   *        copying it
+   * @tparam T Element type
+   * @param data Buffer holding at least as many elements as the dimensions describe
+   * @param dims Dimensions
+   * @return Numeric array
+   */
+  template<typename T, std::enable_if_t<isNumeric<T>, int> = 0>
+  [[nodiscard]] NumericArray<T> makeNumericArrayFromBuffer(std::unique_ptr<T[], Deleter> data, View<std::size_t> dims)
+  {
+    auto array = makeUninitNumericArray<T>(0, 0);
+
+    array.replaceData(std::move(data), dims);
+
+    return array;
+  }
+
+  /**
+   * @brief Creates a numeric matrix that takes ownership of a buffer allocated by mx::malloc or mx::calloc without
+   *        copying it
+   * @tparam T Element type
+   * @param data Buffer holding at least m * n elements
+   * @param m Number of rows
+   * @param n Number of columns
+   * @return Numeric array
+   */
+  template<typename T, std::enable_if_t<isNumeric<T>, int> = 0>
+  [[nodiscard]] NumericArray<T> makeNumericArrayFromBuffer(std::unique_ptr<T[], Deleter> data,
+                                                           std::size_t                    m,
+                                                           std::size_t                    n)
+  {
+    return makeNumericArrayFromBuffer<T>(std::move(data), {{m, n}});
+  }
+
   /**
    * @brief Creates a numeric array of size 1 with the specified value
    * @tparam T Element type
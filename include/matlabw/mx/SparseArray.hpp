@@ -0,0 +1,340 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_SPARSE_ARRAY_HPP
+#define MATLABW_MX_SPARSE_ARRAY_HPP
+
+#include "detail/include.hpp"
+
+#include "Array.hpp"
+#include "common.hpp"
+#include "Exception.hpp"
+#include "SparseArrayRef.hpp"
+#include "typeTraits.hpp"
+
+namespace matlabw::mx
+{
+  /**
+   * @brief Sparse array class. Stores the nonzero elements in compressed sparse column (CSC) format.
+   * @tparam T Value type, one of double, std::complex<double> or bool
+   */
+  template<typename T>
+  class SparseArray : public Array
+  {
+    static_assert(isSparseValue<T> && !std::is_const_v<T>, "T must be double, std::complex<double> or bool");
+
+    public:
+      using value_type = T; ///< Value type
+
+      /// @brief Class ID
+      static constexpr ClassId classId = TypeProperties<T>::classId;
+
+      /// @brief Default constructor
+      SparseArray() noexcept = default;
+
+      /// @brief Explicitly deleted constructor from nullptr.
+      SparseArray(std::nullptr_t) = delete;
+
+      /**
+       * @brief Constructor
+       * @param array mxArray pointer (rvalue reference)
+       */
+      explicit SparseArray(mxArray*&& array)
+      : Array{(detail::checkSparseArray<T>(array), std::move(array))}
+      {}
+
+      /**
+       * @brief Copy constructor from reference
+       * @param other Reference to other array
+       */
+      explicit SparseArray(const ArrayRef& other)
+      : Array{(detail::checkSparseArray<T>(other.get()), other)}
+      {}
+
+      /**
+       * @brief Copy constructor from const reference
+       * @param other Const reference to other array
+       */
+      explicit SparseArray(const ArrayCref& other)
+      : Array{(detail::checkSparseArray<T>(other.get()), other)}
+      {}
+
+      /**
+       * @brief Copy constructor
+       * @param other Other array
+       */
+      explicit SparseArray(const SparseArray& other) = default;
+
+      /**
+       * @brief Move constructor
+       * @param other Other array
+       */
+      SparseArray(SparseArray&& other) noexcept = default;
+
+      /**
+       * @brief Move constructor from an array
+       * @param other Other array
+       */
+      SparseArray(Array&& other)
+      : Array{(detail::checkSparseArray<T>(other.get()), std::move(other))}
+      {}
+
+      /// @brief Destructor
+      ~SparseArray() noexcept = default;
+
+      /**
+       * @brief Copy assignment operator
+       * @param other Other array
+       * @return Reference to this array
+       */
+      SparseArray& operator=(const SparseArray& other) = default;
+
+      /**
+       * @brief Move assignment operator
+       * @param other Other array
+       * @return Reference to this array
+       */
+      SparseArray& operator=(SparseArray&& other) noexcept = default;
+
+      /**
+       * @brief Gets the maximum number of nonzero elements the array can hold without reallocation.
+       * @return The maximum number of nonzero elements
+       */
+      [[nodiscard]] std::size_t getNzmax() const
+      {
+        return SparseArrayCref<T>{*this}.getNzmax();
+      }
+
+      /**
+       * @brief Gets the number of nonzero elements.
+       * @return The number of nonzero elements
+       */
+      [[nodiscard]] std::size_t getNnz() const
+      {
+        return SparseArrayCref<T>{*this}.getNnz();
+      }
+
+      /**
+       * @brief Gets the column start indices. The span has getDimN() + 1 elements.
+       * @return The column start indices
+       */
+      [[nodiscard]] Span<std::size_t> getJc()
+      {
+        return SparseArrayRef<T>{*this}.getJc();
+      }
+
+      /**
+       * @brief Gets the column start indices. The view has getDimN() + 1 elements.
+       * @return The column start indices
+       */
+      [[nodiscard]] View<std::size_t> getJc() const
+      {
+        return SparseArrayCref<T>{*this}.getJc();
+      }
+
+      /**
+       * @brief Gets the row indices. The span has getNzmax() elements.
+       * @return The row indices
+       */
+      [[nodiscard]] Span<std::size_t> getIr()
+      {
+        return SparseArrayRef<T>{*this}.getIr();
+      }
+
+      /**
+       * @brief Gets the row indices. The view has getNzmax() elements.
+       * @return The row indices
+       */
+      [[nodiscard]] View<std::size_t> getIr() const
+      {
+        return SparseArrayCref<T>{*this}.getIr();
+      }
+
+      /**
+       * @brief Gets the values. The span has getNzmax() elements.
+       * @return The values
+       */
+      [[nodiscard]] Span<T> getPr()
+      {
+        return SparseArrayRef<T>{*this}.getPr();
+      }
+
+      /**
+       * @brief Gets the values. The view has getNzmax() elements.
+       * @return The values
+       */
+      [[nodiscard]] View<T> getPr() const
+      {
+        return SparseArrayCref<T>{*this}.getPr();
+      }
+
+      /**
+       * @brief Gets a column.
+       * @param j Column index
+       * @return The column
+       */
+      [[nodiscard]] SparseColumn<T> getColumn(std::size_t j)
+      {
+        return SparseArrayRef<T>{*this}.getColumn(j);
+      }
+
+      /**
+       * @brief Gets a column.
+       * @param j Column index
+       * @return The column
+       */
+      [[nodiscard]] SparseColumn<const T> getColumn(std::size_t j) const
+      {
+        return SparseArrayCref<T>{*this}.getColumn(j);
+      }
+
+      /**
+       * @brief Gets the range of columns.
+       * @return The range of columns
+       */
+      [[nodiscard]] std::ranges::subrange<SparseColumnIterator<T>> getColumns()
+      {
+        return SparseArrayRef<T>{*this}.getColumns();
+      }
+
+      /**
+       * @brief Gets the range of columns.
+       * @return The range of columns
+       */
+      [[nodiscard]] std::ranges::subrange<SparseColumnIterator<const T>> getColumns() const
+      {
+        return SparseArrayCref<T>{*this}.getColumns();
+      }
+
+      /**
+       * @brief Gets the range of nonzero elements in column-major order.
+       * @return The range of nonzero elements
+       */
+      [[nodiscard]] std::ranges::subrange<SparseElementIterator<T>> getNonzeros()
+      {
+        return SparseArrayRef<T>{*this}.getNonzeros();
+      }
+
+      /**
+       * @brief Gets the range of nonzero elements in column-major order.
+       * @return The range of nonzero elements
+       */
+      [[nodiscard]] std::ranges::subrange<SparseElementIterator<const T>> getNonzeros() const
+      {
+        return SparseArrayCref<T>{*this}.getNonzeros();
+      }
+
+      /**
+       * @brief Sets the maximum number of nonzero elements. Invalidates the spans and iterators.
+       * @param nzmax The maximum number of nonzero elements, must not be less than the number of nonzero elements
+       */
+      void setNzmax(std::size_t nzmax)
+      {
+        SparseArrayRef<T>{*this}.setNzmax(nzmax);
+      }
+
+      /**
+       * @brief Ensures the array can hold at least nnz nonzero elements with amortized reallocation. Invalidates the
+       *        spans and iterators if a reallocation occurs.
+       * @param nnz The required number of nonzero elements
+       */
+      void reserve(std::size_t nnz)
+      {
+        SparseArrayRef<T>{*this}.reserve(nnz);
+      }
+
+      /// @brief Reduces the maximum number of nonzero elements to the number of nonzero elements.
+      void shrinkToFit()
+      {
+        SparseArrayRef<T>{*this}.shrinkToFit();
+      }
+
+      /// @brief Use the Array::operator ArrayRef
+      using Array::operator ArrayRef;
+
+      /// @brief Use the Array::operator ArrayCref
+      using Array::operator ArrayCref;
+
+      /**
+       * @brief Conversion operator to SparseArrayRef
+       * @return Reference to the array
+       */
+      [[nodiscard]] operator SparseArrayRef<T>()
+      {
+        checkValid("matlabw:mx:SparseArray:operatorSparseArrayRef");
+        return SparseArrayRef<T>{get()};
+      }
+
+      /**
+       * @brief Conversion operator to SparseArrayCref
+       * @return Const reference to the array
+       */
+      [[nodiscard]] operator SparseArrayCref<T>() const
+      {
+        checkValid("matlabw:mx:SparseArray:operatorSparseArrayCref");
+        return SparseArrayCref<T>{get()};
+      }
+  };
+
+  /// @brief SparseLogicalArray class
+  using SparseLogicalArray = SparseArray<bool>;
+
+  /// @brief SparseLogicalArrayRef class
+  using SparseLogicalArrayRef = SparseArrayRef<bool>;
+
+  /// @brief SparseLogicalArrayCref class
+  using SparseLogicalArrayCref = SparseArrayCref<bool>;
+
+  /**
+   * @brief Creates a sparse array with all elements zero.
+   * @tparam T Value type, one of double, std::complex<double> or bool
+   * @param m Number of rows
+   * @param n Number of columns
+   * @param nzmax Maximum number of nonzero elements
+   * @return Sparse array
+   */
+  template<typename T, std::enable_if_t<isSparseValue<T>, int> = 0>
+  [[nodiscard]] SparseArray<T> makeSparseArray(std::size_t m, std::size_t n, std::size_t nzmax)
+  {
+    mxArray* array{};
+
+    if constexpr (std::is_same_v<T, bool>)
+    {
+      array = mxCreateSparseLogicalMatrix(m, n, nzmax);
+    }
+    else
+    {
+      array = mxCreateSparse(m, n, nzmax, static_cast<mxComplexity>(TypeProperties<T>::complexity));
+    }
+
+    if (array == nullptr)
+    {
+      throw Exception{"failed to create sparse array"};
+    }
+
+    return SparseArray<T>{std::move(array)};
+  }
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_SPARSE_ARRAY_HPP */
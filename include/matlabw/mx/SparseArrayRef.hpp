@@ -0,0 +1,743 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_SPARSE_ARRAY_REF_HPP
+#define MATLABW_MX_SPARSE_ARRAY_REF_HPP
+
+#include "detail/include.hpp"
+
+#include "ArrayRef.hpp"
+#include "common.hpp"
+#include "Exception.hpp"
+#include "typeTraits.hpp"
+
+namespace matlabw::mx
+{
+namespace detail
+{
+  /**
+   * @brief Checks if the array is a sparse array of the correct class and complexity.
+   * @tparam T Value type
+   * @param array mxArray pointer
+   */
+  template<typename T>
+  void checkSparseArray(const mxArray* array)
+  {
+    checkThread("matlabw:mx:checkSparseArray");
+
+    if (array == nullptr)
+    {
+      throw Exception{"invalid array"};
+    }
+
+    if (!mxIsSparse(array))
+    {
+      throw Exception{"array must be sparse"};
+    }
+
+    if (static_cast<ClassId>(mxGetClassID(array)) != TypeProperties<T>::classId
+        || mxIsComplex(array) != (TypeProperties<T>::complexity == Complexity::complex))
+    {
+      throw Exception{"invalid array class"};
+    }
+  }
+} // namespace detail
+
+  /**
+   * @brief A column of a sparse array.
+   * @tparam T Value type, const qualified for read-only access
+   */
+  template<typename T>
+  struct SparseColumn
+  {
+    std::size_t       index{};  ///< Column index
+    View<std::size_t> rows{};   ///< Row indices of the nonzero elements
+    Span<T>           values{}; ///< Values of the nonzero elements
+
+    /**
+     * @brief Gets the number of nonzero elements in the column.
+     * @return Number of nonzero elements
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+      return values.size();
+    }
+  };
+
+  /**
+   * @brief A nonzero element of a sparse array.
+   * @tparam T Value type, const qualified for read-only access
+   */
+  template<typename T>
+  struct SparseElement
+  {
+    std::size_t row;   ///< Row index
+    std::size_t col;   ///< Column index
+    T&          value; ///< Value
+  };
+
+  /**
+   * @brief Iterator over the columns of a sparse array.
+   * @tparam T Value type, const qualified for read-only access
+   */
+  template<typename T>
+  class SparseColumnIterator
+  {
+    public:
+      using iterator_concept  = std::random_access_iterator_tag; ///< Iterator concept
+      using iterator_category = std::input_iterator_tag;         ///< Iterator category
+      using value_type        = SparseColumn<T>;                 ///< Value type
+      using difference_type   = std::ptrdiff_t;                  ///< Difference type
+      using reference         = SparseColumn<T>;                 ///< Reference type
+
+      /// @brief Default constructor
+      SparseColumnIterator() noexcept = default;
+
+      /**
+       * @brief Constructor
+       * @param jc Column start indices
+       * @param ir Row indices
+       * @param pr Values
+       * @param j Column index
+       */
+      SparseColumnIterator(const std::size_t* jc, const std::size_t* ir, T* pr, std::size_t j) noexcept
+      : mJc{jc}, mIr{ir}, mPr{pr}, mCol{j}
+      {}
+
+      /**
+       * @brief Dereference operator
+       * @return The column
+       */
+      [[nodiscard]] reference operator*() const noexcept
+      {
+        return (*this)[0];
+      }
+
+      /**
+       * @brief Subscript operator
+       * @param n Offset
+       * @return The column at the offset
+       */
+      [[nodiscard]] reference operator[](difference_type n) const noexcept
+      {
+        const std::size_t j     = static_cast<std::size_t>(static_cast<difference_type>(mCol) + n);
+        const std::size_t first = mJc[j];
+        const std::size_t count = mJc[j + 1] - first;
+
+        return SparseColumn<T>{j, View<std::size_t>{mIr + first, count}, Span<T>{mPr + first, count}};
+      }
+
+      /**
+       * @brief Pre-increment operator
+       * @return Reference to this iterator
+       */
+      SparseColumnIterator& operator++() noexcept
+      {
+        ++mCol;
+        return *this;
+      }
+
+      /**
+       * @brief Post-increment operator
+       * @return Copy of this iterator before increment
+       */
+      SparseColumnIterator operator++(int) noexcept
+      {
+        return std::exchange(*this, std::next(*this));
+      }
+
+      /**
+       * @brief Pre-decrement operator
+       * @return Reference to this iterator
+       */
+      SparseColumnIterator& operator--() noexcept
+      {
+        --mCol;
+        return *this;
+      }
+
+      /**
+       * @brief Post-decrement operator
+       * @return Copy of this iterator before decrement
+       */
+      SparseColumnIterator operator--(int) noexcept
+      {
+        return std::exchange(*this, std::prev(*this));
+      }
+
+      /**
+       * @brief Compound addition operator
+       * @param n Offset
+       * @return Reference to this iterator
+       */
+      SparseColumnIterator& operator+=(difference_type n) noexcept
+      {
+        mCol = static_cast<std::size_t>(static_cast<difference_type>(mCol) + n);
+        return *this;
+      }
+
+      /**
+       * @brief Compound subtraction operator
+       * @param n Offset
+       * @return Reference to this iterator
+       */
+      SparseColumnIterator& operator-=(difference_type n) noexcept
+      {
+        return *this += -n;
+      }
+
+      /**
+       * @brief Addition operator
+       * @param it Iterator
+       * @param n Offset
+       * @return Advanced iterator
+       */
+      [[nodiscard]] friend SparseColumnIterator operator+(SparseColumnIterator it, difference_type n) noexcept
+      {
+        return it += n;
+      }
+
+      /**
+       * @brief Addition operator
+       * @param n Offset
+       * @param it Iterator
+       * @return Advanced iterator
+       */
+      [[nodiscard]] friend SparseColumnIterator operator+(difference_type n, SparseColumnIterator it) noexcept
+      {
+        return it += n;
+      }
+
+      /**
+       * @brief Subtraction operator
+       * @param it Iterator
+       * @param n Offset
+       * @return Advanced iterator
+       */
+      [[nodiscard]] friend SparseColumnIterator operator-(SparseColumnIterator it, difference_type n) noexcept
+      {
+        return it -= n;
+      }
+
+      /**
+       * @brief Difference operator
+       * @param lhs Left-hand side iterator
+       * @param rhs Right-hand side iterator
+       * @return Distance between the iterators
+       */
+      [[nodiscard]] friend difference_type operator-(const SparseColumnIterator& lhs,
+                                                     const SparseColumnIterator& rhs) noexcept
+      {
+        return static_cast<difference_type>(lhs.mCol) - static_cast<difference_type>(rhs.mCol);
+      }
+
+      /**
+       * @brief Equality operator
+       * @param lhs Left-hand side iterator
+       * @param rhs Right-hand side iterator
+       * @return True if the iterators are equal
+       */
+      [[nodiscard]] friend bool operator==(const SparseColumnIterator& lhs, const SparseColumnIterator& rhs) noexcept
+      {
+        return lhs.mCol == rhs.mCol;
+      }
+
+      /**
+       * @brief Three-way comparison operator
+       * @param lhs Left-hand side iterator
+       * @param rhs Right-hand side iterator
+       * @return Ordering of the iterators
+       */
+      [[nodiscard]] friend auto operator<=>(const SparseColumnIterator& lhs, const SparseColumnIterator& rhs) noexcept
+      {
+        return lhs.mCol <=> rhs.mCol;
+      }
+    private:
+      const std::size_t* mJc{};  ///< Column start indices
+      const std::size_t* mIr{};  ///< Row indices
+      T*                 mPr{};  ///< Values
+      std::size_t        mCol{}; ///< Column index
+  };
+
+  /**
+   * @brief Iterator over the nonzero elements of a sparse array in column-major order.
+   * @tparam T Value type, const qualified for read-only access
+   */
+  template<typename T>
+  class SparseElementIterator
+  {
+    public:
+      using iterator_concept  = std::forward_iterator_tag; ///< Iterator concept
+      using iterator_category = std::input_iterator_tag;   ///< Iterator category
+      using value_type        = SparseElement<T>;          ///< Value type
+      using difference_type   = std::ptrdiff_t;            ///< Difference type
+      using reference         = SparseElement<T>;          ///< Reference type
+
+      /// @brief Default constructor
+      SparseElementIterator() noexcept = default;
+
+      /**
+       * @brief Constructor
+       * @param jc Column start indices
+       * @param ir Row indices
+       * @param pr Values
+       * @param n Number of columns
+       * @param k Nonzero element index, must be either 0 or the number of nonzero elements
+       */
+      SparseElementIterator(const std::size_t* jc, const std::size_t* ir, T* pr, std::size_t n, std::size_t k) noexcept
+      : mJc{jc}, mIr{ir}, mPr{pr}, mN{n}, mK{k}
+      {
+        skipEmptyColumns();
+      }
+
+      /**
+       * @brief Dereference operator
+       * @return The nonzero element
+       */
+      [[nodiscard]] reference operator*() const noexcept
+      {
+        return SparseElement<T>{mIr[mK], mCol, mPr[mK]};
+      }
+
+      /**
+       * @brief Pre-increment operator
+       * @return Reference to this iterator
+       */
+      SparseElementIterator& operator++() noexcept
+      {
+        ++mK;
+        skipEmptyColumns();
+        return *this;
+      }
+
+      /**
+       * @brief Post-increment operator
+       * @return Copy of this iterator before increment
+       */
+      SparseElementIterator operator++(int) noexcept
+      {
+        return std::exchange(*this, std::next(*this));
+      }
+
+      /**
+       * @brief Equality operator
+       * @param lhs Left-hand side iterator
+       * @param rhs Right-hand side iterator
+       * @return True if the iterators are equal
+       */
+      [[nodiscard]] friend bool operator==(const SparseElementIterator& lhs, const SparseElementIterator& rhs) noexcept
+      {
+        return lhs.mK == rhs.mK;
+      }
+    private:
+      /// @brief Advances the column index to the column containing the current element.
+      void skipEmptyColumns() noexcept
+      {
+        while (mCol < mN && mK >= mJc[mCol + 1])
+        {
+          ++mCol;
+        }
+      }
+
+      const std::size_t* mJc{};  ///< Column start indices
+      const std::size_t* mIr{};  ///< Row indices
+      T*                 mPr{};  ///< Values
+      std::size_t        mN{};   ///< Number of columns
+      std::size_t        mK{};   ///< Nonzero element index
+      std::size_t        mCol{}; ///< Column index
+  };
+
+  /**
+   * @brief Sparse array reference class.
+   * @tparam T Value type, one of double, std::complex<double> or bool
+   */
+  template<typename T>
+  class SparseArrayRef : public ArrayRef
+  {
+    static_assert(isSparseValue<T> && !std::is_const_v<T>, "T must be double, std::complex<double> or bool");
+
+    public:
+      using value_type = T; ///< Value type
+
+      /// @brief Class ID
+      static constexpr ClassId classId = TypeProperties<T>::classId;
+
+      /// @brief Explicitly deleted default constructor.
+      SparseArrayRef() = delete;
+
+      /// @brief Explicitly deleted constructor from nullptr.
+      SparseArrayRef(std::nullptr_t) = delete;
+
+      /**
+       * @brief Constructor from a mxArray pointer.
+       * @param array mxArray pointer
+       */
+      explicit SparseArrayRef(mxArray* array)
+      : ArrayRef{(detail::checkSparseArray<T>(array), array)}
+      {}
+
+      /**
+       * @brief Constructor from an ArrayRef.
+       * @param other ArrayRef
+       */
+      explicit SparseArrayRef(const ArrayRef& other)
+      : ArrayRef{(detail::checkSparseArray<T>(other.get()), other)}
+      {}
+
+      /**
+       * @brief Assignment operator from an ArrayRef.
+       * @param other ArrayRef
+       * @return Reference to this
+       */
+      SparseArrayRef& operator=(const ArrayRef& other)
+      {
+        detail::checkSparseArray<T>(other.get());
+        ArrayRef::operator=(other);
+        return *this;
+      }
+
+      /**
+       * @brief Gets the maximum number of nonzero elements the array can hold without reallocation.
+       * @return The maximum number of nonzero elements
+       */
+      [[nodiscard]] std::size_t getNzmax() const
+      {
+        checkThread("matlabw:mx:SparseArrayRef:getNzmax");
+
+        return mxGetNzmax(mArray);
+      }
+
+      /**
+       * @brief Gets the number of nonzero elements.
+       * @return The number of nonzero elements
+       */
+      [[nodiscard]] std::size_t getNnz() const
+      {
+        return getJc()[getDimN()];
+      }
+
+      /**
+       * @brief Gets the column start indices. The span has getDimN() + 1 elements.
+       * @return The column start indices
+       */
+      [[nodiscard]] Span<std::size_t> getJc() const
+      {
+        checkThread("matlabw:mx:SparseArrayRef:getJc");
+
+        return Span<std::size_t>{mxGetJc(mArray), getDimN() + 1};
+      }
+
+      /**
+       * @brief Gets the row indices. The span has getNzmax() elements.
+       * @return The row indices
+       */
+      [[nodiscard]] Span<std::size_t> getIr() const
+      {
+        checkThread("matlabw:mx:SparseArrayRef:getIr");
+
+        return Span<std::size_t>{mxGetIr(mArray), getNzmax()};
+      }
+
+      /**
+       * @brief Gets the values. The span has getNzmax() elements.
+       * @return The values
+       */
+      [[nodiscard]] Span<T> getPr() const
+      {
+        checkThread("matlabw:mx:SparseArrayRef:getPr");
+
+        return Span<T>{static_cast<T*>(mxGetData(mArray)), getNzmax()};
+      }
+
+      /**
+       * @brief Gets a column.
+       * @param j Column index
+       * @return The column
+       */
+      [[nodiscard]] SparseColumn<T> getColumn(std::size_t j) const
+      {
+        if (j >= getDimN())
+        {
+          throw Exception{"matlabw:mx:SparseArrayRef:getColumn", "index out of range"};
+        }
+
+        return columnsBegin()[static_cast<std::ptrdiff_t>(j)];
+      }
+
+      /**
+       * @brief Gets the range of columns.
+       * @return The range of columns
+       */
+      [[nodiscard]] std::ranges::subrange<SparseColumnIterator<T>> getColumns() const
+      {
+        const auto first = columnsBegin();
+
+        return {first, first + static_cast<std::ptrdiff_t>(getDimN())};
+      }
+
+      /**
+       * @brief Gets the range of nonzero elements in column-major order.
+       * @return The range of nonzero elements
+       */
+      [[nodiscard]] std::ranges::subrange<SparseElementIterator<T>> getNonzeros() const
+      {
+        checkThread("matlabw:mx:SparseArrayRef:getNonzeros");
+
+        const std::size_t  n  = getDimN();
+        const std::size_t* jc = mxGetJc(mArray);
+        const std::size_t* ir = mxGetIr(mArray);
+        T*                 pr = static_cast<T*>(mxGetData(mArray));
+
+        return {SparseElementIterator<T>{jc, ir, pr, n, 0}, SparseElementIterator<T>{jc, ir, pr, n, jc[n]}};
+      }
+
+      /**
+       * @brief Sets the maximum number of nonzero elements. Invalidates the spans and iterators.
+       * @param nzmax The maximum number of nonzero elements, must not be less than the number of nonzero elements
+       */
+      void setNzmax(std::size_t nzmax) const
+      {
+        checkThread("matlabw:mx:SparseArrayRef:setNzmax");
+
+        if (nzmax < getNnz())
+        {
+          throw Exception{"matlabw:mx:SparseArrayRef:setNzmax", "nzmax must not be less than the number of nonzeros"};
+        }
+
+        mxSetNzmax(mArray, std::max(nzmax, std::size_t{1}));
+      }
+
+      /**
+       * @brief Ensures the array can hold at least nnz nonzero elements. The capacity grows geometrically, so repeated
+       *        calls with an increasing count reallocate amortized constant times. Invalidates the spans and
+       *        iterators if a reallocation occurs.
+       * @param nnz The required number of nonzero elements
+       */
+      void reserve(std::size_t nnz) const
+      {
+        checkThread("matlabw:mx:SparseArrayRef:reserve");
+
+        const std::size_t nzmax = getNzmax();
+
+        if (nnz > nzmax)
+        {
+          mxSetNzmax(mArray, std::max(nnz, nzmax + nzmax / 2));
+        }
+      }
+
+      /// @brief Reduces the maximum number of nonzero elements to the number of nonzero elements.
+      void shrinkToFit() const
+      {
+        setNzmax(getNnz());
+      }
+    private:
+      /**
+       * @brief Gets the iterator to the first column.
+       * @return The iterator to the first column
+       */
+      [[nodiscard]] SparseColumnIterator<T> columnsBegin() const
+      {
+        checkThread("matlabw:mx:SparseArrayRef:columnsBegin");
+
+        return SparseColumnIterator<T>{mxGetJc(mArray), mxGetIr(mArray), static_cast<T*>(mxGetData(mArray)), 0};
+      }
+  };
+
+  /**
+   * @brief Sparse array const reference class.
+   * @tparam T Value type, one of double, std::complex<double> or bool
+   */
+  template<typename T>
+  class SparseArrayCref : public ArrayCref
+  {
+    static_assert(isSparseValue<T> && !std::is_const_v<T>, "T must be double, std::complex<double> or bool");
+
+    public:
+      using value_type = const T; ///< Value type
+
+      /// @brief Class ID
+      static constexpr ClassId classId = TypeProperties<T>::classId;
+
+      /// @brief Explicitly deleted default constructor.
+      SparseArrayCref() = delete;
+
+      /// @brief Explicitly deleted constructor from nullptr.
+      SparseArrayCref(std::nullptr_t) = delete;
+
+      /**
+       * @brief Constructor from a mxArray pointer.
+       * @param array mxArray pointer
+       */
+      explicit SparseArrayCref(const mxArray* array)
+      : ArrayCref{(detail::checkSparseArray<T>(array), array)}
+      {}
+
+      /**
+       * @brief Constructor from an ArrayCref.
+       * @param other ArrayCref
+       */
+      explicit SparseArrayCref(const ArrayCref& other)
+      : ArrayCref{(detail::checkSparseArray<T>(other.get()), other)}
+      {}
+
+      /**
+       * @brief Constructor from an ArrayRef.
+       * @param other ArrayRef
+       */
+      explicit SparseArrayCref(const ArrayRef& other)
+      : ArrayCref{(detail::checkSparseArray<T>(other.get()), other)}
+      {}
+
+      /**
+       * @brief Constructor from a SparseArrayRef.
+       * @param other SparseArrayRef
+       */
+      SparseArrayCref(const SparseArrayRef<T>& other)
+      : ArrayCref{other}
+      {}
+
+      /**
+       * @brief Assignment operator from an ArrayCref.
+       * @param other ArrayCref
+       * @return Reference to this
+       */
+      SparseArrayCref& operator=(const ArrayCref& other)
+      {
+        detail::checkSparseArray<T>(other.get());
+        ArrayCref::operator=(other);
+        return *this;
+      }
+
+      /**
+       * @brief Gets the maximum number of nonzero elements the array can hold without reallocation.
+       * @return The maximum number of nonzero elements
+       */
+      [[nodiscard]] std::size_t getNzmax() const
+      {
+        checkThread("matlabw:mx:SparseArrayCref:getNzmax");
+
+        return mxGetNzmax(mArray);
+      }
+
+      /**
+       * @brief Gets the number of nonzero elements.
+       * @return The number of nonzero elements
+       */
+      [[nodiscard]] std::size_t getNnz() const
+      {
+        return getJc()[getDimN()];
+      }
+
+      /**
+       * @brief Gets the column start indices. The view has getDimN() + 1 elements.
+       * @return The column start indices
+       */
+      [[nodiscard]] View<std::size_t> getJc() const
+      {
+        checkThread("matlabw:mx:SparseArrayCref:getJc");
+
+        return View<std::size_t>{mxGetJc(mArray), getDimN() + 1};
+      }
+
+      /**
+       * @brief Gets the row indices. The view has getNzmax() elements.
+       * @return The row indices
+       */
+      [[nodiscard]] View<std::size_t> getIr() const
+      {
+        checkThread("matlabw:mx:SparseArrayCref:getIr");
+
+        return View<std::size_t>{mxGetIr(mArray), getNzmax()};
+      }
+
+      /**
+       * @brief Gets the values. The view has getNzmax() elements.
+       * @return The values
+       */
+      [[nodiscard]] View<T> getPr() const
+      {
+        checkThread("matlabw:mx:SparseArrayCref:getPr");
+
+        return View<T>{static_cast<const T*>(mxGetData(mArray)), getNzmax()};
+      }
+
+      /**
+       * @brief Gets a column.
+       * @param j Column index
+       * @return The column
+       */
+      [[nodiscard]] SparseColumn<const T> getColumn(std::size_t j) const
+      {
+        if (j >= getDimN())
+        {
+          throw Exception{"matlabw:mx:SparseArrayCref:getColumn", "index out of range"};
+        }
+
+        return columnsBegin()[static_cast<std::ptrdiff_t>(j)];
+      }
+
+      /**
+       * @brief Gets the range of columns.
+       * @return The range of columns
+       */
+      [[nodiscard]] std::ranges::subrange<SparseColumnIterator<const T>> getColumns() const
+      {
+        const auto first = columnsBegin();
+
+        return {first, first + static_cast<std::ptrdiff_t>(getDimN())};
+      }
+
+      /**
+       * @brief Gets the range of nonzero elements in column-major order.
+       * @return The range of nonzero elements
+       */
+      [[nodiscard]] std::ranges::subrange<SparseElementIterator<const T>> getNonzeros() const
+      {
+        checkThread("matlabw:mx:SparseArrayCref:getNonzeros");
+
+        const std::size_t  n  = getDimN();
+        const std::size_t* jc = mxGetJc(mArray);
+        const std::size_t* ir = mxGetIr(mArray);
+        const T*           pr = static_cast<const T*>(mxGetData(mArray));
+
+        return {SparseElementIterator<const T>{jc, ir, pr, n, 0}, SparseElementIterator<const T>{jc, ir, pr, n, jc[n]}};
+      }
+    private:
+      /**
+       * @brief Gets the iterator to the first column.
+       * @return The iterator to the first column
+       */
+      [[nodiscard]] SparseColumnIterator<const T> columnsBegin() const
+      {
+        checkThread("matlabw:mx:SparseArrayCref:columnsBegin");
+
+        return SparseColumnIterator<const T>{mxGetJc(mArray),
+                                             mxGetIr(mArray),
+                                             static_cast<const T*>(mxGetData(mArray)),
+                                             0};
+      }
+  };
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_SPARSE_ARRAY_REF_HPP */
@@ -409,6 +409,41 @@ namespace matlabw::mx
         return getFieldIndex(fieldName.data());
       }
 
+      /**
+       * @brief Gathers a field of all structures into one array, e.g. [s.timestamp]. Every structure must hold a real or
+       *        complex (as T) array of class T with the same number of elements, a scalar or a vector. The field values
+       *        are validated in one pass, then copied in parallel.
+       * @tparam T The type of the field elements.
+       * @param fieldIndex The field index.
+       * @return LxN array, where L is the number of elements per field value and N the number of structures.
+       */
+      template<typename T, std::enable_if_t<mx::isNumeric<T>, int> = 0>
+      [[nodiscard]] NumericArray<T> gatherField(FieldIndex fieldIndex) const
+      {
+        checkValid("matlabw::mx::StructArray::gatherField");
+
+        return detail::gatherField<T>(get(), fieldIndex);
+      }
+
+      /**
+       * @brief Gathers a field of all structures into one array, see gatherField(FieldIndex).
+       * @tparam T The type of the field elements.
+       * @param fieldName The field name. Must be null-terminated.
+       * @return LxN array, where L is the number of elements per field value and N the number of structures.
+       */
+      template<typename T, std::enable_if_t<mx::isNumeric<T>, int> = 0>
+      [[nodiscard]] NumericArray<T> gatherField(std::string_view fieldName) const
+      {
+        const FieldIndex fieldIndex = getFieldIndex(fieldName.data());
+
+        if (fieldIndex == FieldIndex::invalid)
+        {
+          throw Exception{"matlabw:mx:gatherField", "missing field '" + std::string{fieldName} + "'"};
+        }
+
+        return gatherField<T>(fieldIndex);
+      }
+
       /**
        * @brief Adds a field to the structure array.
        * @param fieldName The field name.
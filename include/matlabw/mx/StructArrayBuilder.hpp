@@ -0,0 +1,204 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_STRUCT_ARRAY_BUILDER_HPP
+#define MATLABW_MX_STRUCT_ARRAY_BUILDER_HPP
+
+#include "detail/include.hpp"
+#include "detail/parallel.hpp"
+
+#include "common.hpp"
+#include "Exception.hpp"
+#include "NumericArray.hpp"
+#include "StructArray.hpp"
+#include "threadCheck.hpp"
+
+namespace matlabw::mx
+{
+  /**
+   * @brief Builds a 1xN structure array from typed columns. All field values are created in one sweep on the main
+   *        thread, then filled in parallel.
+   */
+  class StructArrayBuilder
+  {
+    public:
+      /**
+       * @brief Constructor.
+       * @param count The number of structures.
+       */
+      explicit StructArrayBuilder(std::size_t count)
+      : mCount{count}
+      {}
+
+      /// @brief Copy constructor.
+      StructArrayBuilder(const StructArrayBuilder&) = default;
+
+      /// @brief Move constructor.
+      StructArrayBuilder(StructArrayBuilder&&) = default;
+
+      /// @brief Destructor.
+      ~StructArrayBuilder() = default;
+
+      /// @brief Copy assignment operator.
+      StructArrayBuilder& operator=(const StructArrayBuilder&) = default;
+
+      /// @brief Move assignment operator.
+      StructArrayBuilder& operator=(StructArrayBuilder&&) = default;
+
+      /**
+       * @brief Adds a field filled from a column. The column must outlive the call to build().
+       * @tparam T The type of the field elements.
+       * @param name The field name.
+       * @param column The column holding length values per structure, i.e. an LxN array in column-major order.
+       * @param length The number of elements of each field value, the values are 1xL arrays.
+       * @return The field index.
+       */
+      template<typename T, std::enable_if_t<isNumeric<T>, int> = 0>
+      FieldIndex addField(std::string name, View<T> column, std::size_t length = 1)
+      {
+        if (column.size() != mCount * length)
+        {
+          throw Exception{"matlabw:mx:StructArrayBuilder:addField", "column size does not match the field length"};
+        }
+
+        return addField<T>(std::move(name), [column, length](std::size_t i, Span<T> value)
+        {
+          std::copy_n(column.data() + i * length, length, value.data());
+        }, length);
+      }
+
+      /**
+       * @brief Adds a field filled by a function. The function is called as fill(i, value) for each structure index i
+       *        concurrently from the thread pool, so it must not call the MATLAB API.
+       * @tparam T The type of the field elements.
+       * @tparam Fn The fill function type.
+       * @param name The field name.
+       * @param fill The fill function, it receives the 1xL uninitialized value of the structure i.
+       * @param length The number of elements of each field value.
+       * @return The field index.
+       */
+      template<typename T,
+               typename Fn,
+               std::enable_if_t<isNumeric<T> && std::is_invocable_v<Fn&, std::size_t, Span<T>>, int> = 0>
+      FieldIndex addField(std::string name, Fn fill, std::size_t length = 1)
+      {
+        mFields.push_back(Field{std::move(name),
+                                TypeProperties<T>::classId,
+                                TypeProperties<T>::complexity,
+                                length,
+                                [fill = std::move(fill), length](std::size_t begin, std::size_t end, void* const* values)
+                                {
+                                  for (std::size_t i{begin}; i < end; ++i)
+                                  {
+                                    fill(i, Span<T>{static_cast<T*>(values[i]), length});
+                                  }
+                                }});
+
+        return static_cast<FieldIndex>(mFields.size() - 1);
+      }
+
+      /**
+       * @brief Gets the number of structures.
+       * @return The number of structures.
+       */
+      [[nodiscard]] std::size_t getCount() const noexcept
+      {
+        return mCount;
+      }
+
+      /**
+       * @brief Gets the number of fields.
+       * @return The number of fields.
+       */
+      [[nodiscard]] std::size_t getFieldCount() const noexcept
+      {
+        return mFields.size();
+      }
+
+      /**
+       * @brief Builds the structure array.
+       * @return The 1xN structure array.
+       */
+      [[nodiscard]] StructArray build() const
+      {
+        static constexpr char id[]{"matlabw:mx:StructArrayBuilder:build"};
+
+        checkThread(id);
+
+        std::vector<const char*> names(mFields.size());
+
+        std::transform(mFields.begin(), mFields.end(), names.begin(), [](const Field& field)
+        {
+          return field.name.c_str();
+        });
+
+        StructArray array = makeStructArray(1, mCount, names);
+
+        // The array owns the values as soon as they are set, the fill below only writes their data.
+        std::vector<void*> values(mFields.size() * mCount);
+        std::size_t        recordLength{};
+
+        for (std::size_t k{}; k < mFields.size(); ++k)
+        {
+          const Field& field = mFields[k];
+
+          for (std::size_t i{}; i < mCount; ++i)
+          {
+            Array value = makeUninitNumericArray(1, field.length, field.classId, field.complexity);
+
+            values[k * mCount + i] = mxGetData(value.get());
+
+            mxSetFieldByNumber(array.get(), i, static_cast<int>(k), value.release());
+          }
+
+          recordLength += field.length;
+        }
+
+        detail::parallelFor<std::byte>(mCount, [&](std::size_t begin, std::size_t end)
+        {
+          for (std::size_t k{}; k < mFields.size(); ++k)
+          {
+            mFields[k].fill(begin, end, values.data() + k * mCount);
+          }
+        }, std::max<std::size_t>(detail::parallelThreshold / std::max<std::size_t>(recordLength, 1), 1));
+
+        return array;
+      }
+    private:
+      /// @brief Field schema.
+      struct Field
+      {
+        std::string                                                  name{};       ///< The field name.
+        ClassId                                                      classId{};    ///< The element class ID.
+        Complexity                                                   complexity{}; ///< The element complexity.
+        std::size_t                                                  length{};     ///< The number of elements.
+        std::function<void(std::size_t, std::size_t, void* const*)> fill{};       ///< Fills the values [begin, end).
+      };
+
+      std::size_t        mCount{};  ///< The number of structures.
+      std::vector<Field> mFields{}; ///< The fields.
+  };
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_STRUCT_ARRAY_BUILDER_HPP */
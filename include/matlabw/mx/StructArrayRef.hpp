@@ -26,12 +26,95 @@
 #define MATLABW_MX_STRUCT_ARRAY_REF_HPP
 
 #include "detail/include.hpp"
+#include "detail/parallel.hpp"
 
 #include "Array.hpp"
+#include "NumericArray.hpp"
+#include "threadCheck.hpp"
 #include "TypedArrayRef.hpp"
 
 namespace matlabw::mx
 {
+namespace detail
+{
+  /**
+   * @brief Gathers a field of all structures of a structure array into one LxN array. The field values are validated
+   *        and their data pointers collected on the calling thread, the copy runs on the shared thread pool.
+   * @tparam T The type of the field elements.
+   * @param array The structure array.
+   * @param fieldIndex The field index.
+   * @return The gathered array.
+   */
+  template<typename T>
+  [[nodiscard]] NumericArray<T> gatherField(const mxArray* array, FieldIndex fieldIndex)
+  {
+    static constexpr char id[]{"matlabw:mx:gatherField"};
+
+    checkThread(id);
+
+    if (fieldIndex == FieldIndex::invalid
+        || static_cast<std::size_t>(fieldIndex) >= static_cast<std::size_t>(mxGetNumberOfFields(array)))
+    {
+      throw Exception{id, "invalid field index"};
+    }
+
+    const int         field = static_cast<int>(fieldIndex);
+    const std::size_t count = mxGetNumberOfElements(array);
+
+    std::vector<const T*> sources(count);
+    std::size_t           length{};
+
+    for (std::size_t i{}; i < count; ++i)
+    {
+      const mxArray* value = mxGetFieldByNumber(array, i, field);
+
+      if (value == nullptr
+          || static_cast<ClassId>(mxGetClassID(value)) != TypeProperties<T>::classId
+          || mxIsSparse(value)
+          || static_cast<bool>(mxIsComplex(value)) != isComplexNumeric<T>)
+      {
+        std::string message{"element "};
+
+        message += std::to_string(i + 1);
+        message += isComplexNumeric<T> ? " must hold a complex " : " must hold a real ";
+        message += getClassName(TypeProperties<T>::classId);
+        message += " array";
+
+        throw Exception{id, std::move(message)};
+      }
+
+      const std::size_t size = mxGetNumberOfElements(value);
+
+      if (i == 0)
+      {
+        length = size;
+      }
+      else if (size != length)
+      {
+        throw Exception{id, "all elements must hold the same number of values"};
+      }
+
+      sources[i] = static_cast<const T*>(mxGetData(value));
+    }
+
+    NumericArray<T> result = makeUninitNumericArray<T>(length, count);
+    T*              dst    = result.getData();
+
+    if (length > 0)
+    {
+      parallelFor<T>(count, [&](std::size_t begin, std::size_t end)
+      {
+        for (std::size_t i{begin}; i < end; ++i)
+        {
+          std::copy_n(sources[i], length, dst + i * length);
+        }
+      }, std::max<std::size_t>(parallelThreshold / length, 1));
+    }
+
+    return result;
+  }
+} // namespace detail
+
   /// @brief StructArrayRef class
   class StructArrayRef : public TypedArrayRef<Struct>
   {
@@ -95,6 +178,8 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::optional<ArrayRef> getField(std::size_t i, FieldIndex fieldIndex)
       {
+        checkThread("matlabw:mx:StructArrayRef:getField");
+
         if (fieldIndex == FieldIndex::invalid)
         {
           return std::nullopt;
@@ -165,6 +250,8 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::optional<ArrayCref> getField(std::size_t i, FieldIndex fieldIndex) const
       {
+        checkThread("matlabw:mx:StructArrayRef:getField");
+
         if (fieldIndex == FieldIndex::invalid)
         {
           return std::nullopt;
@@ -235,6 +322,8 @@ namespace matlabw::mx
        */
       void setField(std::size_t i, FieldIndex fieldIndex, ArrayCref value)
       {
+        checkThread("matlabw:mx:StructArrayRef:setField");
+
         if (fieldIndex == FieldIndex::invalid || static_cast<std::size_t>(fieldIndex) >= getFieldCount())
         {
           throw Exception("invalid field index");
@@ -293,6 +382,8 @@ namespace matlabw::mx
        */
       void setField(std::size_t i, FieldIndex fieldIndex, Array&& value)
       {
+        checkThread("matlabw:mx:StructArrayRef:setField");
+
         if (fieldIndex == FieldIndex::invalid || static_cast<std::size_t>(fieldIndex) >= getFieldCount())
         {
           throw Exception("invalid field index");
@@ -307,6 +398,8 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getFieldCount() const
       {
+        checkThread("matlabw:mx:StructArrayRef:getFieldCount");
+
         return static_cast<std::size_t>(mxGetNumberOfFields(get()));
       }
 
@@ -317,6 +410,8 @@ namespace matlabw::mx
        */
       [[nodiscard]] const char* getFieldName(FieldIndex fieldIdx) const
       {        
+        checkThread("matlabw:mx:StructArrayRef:getFieldName");
+
         const char* fieldName = mxGetFieldNameByNumber(get(), static_cast<int>(fieldIdx));
 
         if (fieldName == nullptr)
@@ -334,6 +429,8 @@ namespace matlabw::mx
        */
       [[nodiscard]] FieldIndex getFieldIndex(const char* fieldName) const
       {
+        checkThread("matlabw:mx:StructArrayRef:getFieldIndex");
+
         int fieldIdx = mxGetFieldNumber(get(), fieldName);
 
         if (fieldIdx == -1)
@@ -354,12 +451,47 @@ namespace matlabw::mx
         return getFieldIndex(fieldName.data());
       }
 
+      /**
+       * @brief Gathers a field of all structures into one array, e.g. [s.timestamp]. Every structure must hold a real or
+       *        complex (as T) array of class T with the same number of elements, a scalar or a vector. The field values
+       *        are validated in one pass, then copied in parallel.
+       * @tparam T The type of the field elements.
+       * @param fieldIndex The field index.
+       * @return LxN array, where L is the number of elements per field value and N the number of structures.
+       */
+      template<typename T, std::enable_if_t<mx::isNumeric<T>, int> = 0>
+      [[nodiscard]] NumericArray<T> gatherField(FieldIndex fieldIndex) const
+      {
+        return detail::gatherField<T>(get(), fieldIndex);
+      }
+
+      /**
+       * @brief Gathers a field of all structures into one array, see gatherField(FieldIndex).
+       * @tparam T The type of the field elements.
+       * @param fieldName The field name. Must be null-terminated.
+       * @return LxN array, where L is the number of elements per field value and N the number of structures.
+       */
+      template<typename T, std::enable_if_t<mx::isNumeric<T>, int> = 0>
+      [[nodiscard]] NumericArray<T> gatherField(std::string_view fieldName) const
+      {
+        const FieldIndex fieldIndex = getFieldIndex(fieldName.data());
+
+        if (fieldIndex == FieldIndex::invalid)
+        {
+          throw Exception{"matlabw:mx:gatherField", "missing field '" + std::string{fieldName} + "'"};
+        }
+
+        return gatherField<T>(fieldIndex);
+      }
+
       /**
        * @brief Adds a field to the structure array.
        * @param fieldName The field name.
        */
       void addField(const char* fieldName)
       {
+        checkThread("matlabw:mx:StructArrayRef:addField");
+
         if (fieldName == nullptr)
         {
           throw Exception("invalid field name");
@@ -409,6 +541,8 @@ namespace matlabw::mx
        */
       void removeField(FieldIndex fieldIndex)
       {
+        checkThread("matlabw:mx:StructArrayRef:removeField");
+
         if (fieldIndex != FieldIndex::invalid)
         {
           if (static_cast<std::size_t>(fieldIndex) >= getFieldCount())
@@ -484,6 +618,8 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::optional<ArrayCref> getField(std::size_t i, FieldIndex fieldIndex) const
       {
+        checkThread("matlabw:mx:StructArrayCref:getField");
+
         if (fieldIndex == FieldIndex::invalid)
         {
           return std::nullopt;
@@ -510,6 +646,8 @@ namespace matlabw::mx
        */
       [[nodiscard]] std::size_t getFieldCount() const
       {
+        checkThread("matlabw:mx:StructArrayCref:getFieldCount");
+
         return static_cast<std::size_t>(mxGetNumberOfFields(get()));
       }
 
@@ -520,6 +658,8 @@ namespace matlabw::mx
        */
       [[nodiscard]] const char* getFieldName(FieldIndex fieldIdx) const
       {        
+        checkThread("matlabw:mx:StructArrayCref:getFieldName");
+
         const char* fieldName = mxGetFieldNameByNumber(get(), static_cast<int>(fieldIdx));
 
         if (fieldName == nullptr)
@@ -537,6 +677,8 @@ namespace matlabw::mx
        */
       [[nodiscard]] FieldIndex getFieldIndex(const char* fieldName) const
       {
+        checkThread("matlabw:mx:StructArrayCref:getFieldIndex");
+
         int fieldIdx = mxGetFieldNumber(get(), fieldName);
 
         if (fieldIdx == -1)
@@ -546,6 +688,39 @@ namespace matlabw::mx
 
         return static_cast<FieldIndex>(fieldIdx);
       }
+
+      /**
+       * @brief Gathers a field of all structures into one array, e.g. [s.timestamp]. Every structure must hold a real or
+       *        complex (as T) array of class T with the same number of elements, a scalar or a vector. The field values
+       *        are validated in one pass, then copied in parallel.
+       * @tparam T The type of the field elements.
+       * @param fieldIndex The field index.
+       * @return LxN array, where L is the number of elements per field value and N the number of structures.
+       */
+      template<typename T, std::enable_if_t<mx::isNumeric<T>, int> = 0>
+      [[nodiscard]] NumericArray<T> gatherField(FieldIndex fieldIndex) const
+      {
+        return detail::gatherField<T>(get(), fieldIndex);
+      }
+
+      /**
+       * @brief Gathers a field of all structures into one array, see gatherField(FieldIndex).
+       * @tparam T The type of the field elements.
+       * @param fieldName The field name. Must be null-terminated.
+       * @return LxN array, where L is the number of elements per field value and N the number of structures.
+       */
+      template<typename T, std::enable_if_t<mx::isNumeric<T>, int> = 0>
+      [[nodiscard]] NumericArray<T> gatherField(std::string_view fieldName) const
+      {
+        const FieldIndex fieldIndex = getFieldIndex(fieldName.data());
+
+        if (fieldIndex == FieldIndex::invalid)
+        {
+          throw Exception{"matlabw:mx:gatherField", "missing field '" + std::string{fieldName} + "'"};
+        }
+
+        return gatherField<T>(fieldIndex);
+      }
   };
 } // namespace matlabw::mx
 
@@ -0,0 +1,400 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_TASK_GROUP_HPP
+#define MATLABW_MX_TASK_GROUP_HPP
+
+#include "detail/include.hpp"
+
+#include "CancellationToken.hpp"
+#include "Exception.hpp"
+#include "ThreadPool.hpp"
+
+namespace matlabw::mx
+{
+  /// @brief Task affinity enumeration.
+  enum class TaskAffinity
+  {
+    any,        ///< The task may run on any thread and must not call into the MATLAB API.
+    mainThread, ///< The task runs on the thread that calls TaskGroup::wait() and may call into the MATLAB API.
+  };
+
+  /**
+   * @brief Group of tasks connected by dependency edges, executed by a work-stealing scheduler on the shared thread
+   *        pool. Each pool thread owns a task queue and steals from the others when its queue runs empty. Tasks with
+   *        main-thread affinity are queued separately and drained by the thread that calls wait(), so mx and mex
+   *        functions stay on the MATLAB thread when wait() is called from mex::Function::operator().
+   */
+  class TaskGroup
+  {
+    public:
+      /// @brief Task identifier.
+      using TaskId = std::size_t;
+
+      /// @brief Default constructor.
+      TaskGroup() = default;
+
+      /**
+       * @brief Constructor. The token is polled before each task starts, once cancellation has been requested the
+       *        remaining tasks are skipped and wait() throws. Long tasks should poll the token themselves as well.
+       * @param token The cancellation token, must outlive the group.
+       */
+      explicit TaskGroup(CancellationToken& token)
+      : mCancellationToken{&token}
+      {}
+
+      /// @brief Explicitly deleted copy constructor.
+      TaskGroup(const TaskGroup&) = delete;
+
+      /// @brief Explicitly deleted move constructor.
+      TaskGroup(TaskGroup&&) = delete;
+
+      /**
+       * @brief Destructor. Tasks only run inside wait(), which returns after all of them have finished, so the tasks
+       *        left at destruction have never started. They are discarded without running, e.g. when an exception
+       *        unwinds the stack between add() and wait(), because they may refer to objects that are already
+       *        destroyed. Call wait() explicitly to run them.
+       */
+      ~TaskGroup() noexcept = default;
+
+      /// @brief Explicitly deleted copy assignment operator.
+      TaskGroup& operator=(const TaskGroup&) = delete;
+
+      /// @brief Explicitly deleted move assignment operator.
+      TaskGroup& operator=(TaskGroup&&) = delete;
+
+      /**
+       * @brief Adds a task to the group.
+       * @param fn The task function.
+       * @param affinity The task affinity.
+       * @return The task identifier.
+       */
+      TaskId add(std::function<void()> fn, TaskAffinity affinity = TaskAffinity::any)
+      {
+        if (!fn)
+        {
+          throw Exception{"matlabw:mx:TaskGroup:add", "invalid task function"};
+        }
+
+        Task& task = mTasks.emplace_back();
+
+        task.fn       = std::move(fn);
+        task.affinity = affinity;
+
+        return mTasks.size() - 1;
+      }
+
+      /**
+       * @brief Adds a dependency edge, the second task starts after the first one has finished.
+       * @param before The task that must finish first.
+       * @param after The task that depends on it.
+       */
+      void precede(TaskId before, TaskId after)
+      {
+        if (before >= mTasks.size() || after >= mTasks.size() || before == after)
+        {
+          throw Exception{"matlabw:mx:TaskGroup:precede", "invalid task identifier"};
+        }
+
+        mTasks[before].successors.push_back(after);
+        ++mTasks[after].dependencyCount;
+      }
+
+      /**
+       * @brief Runs all added tasks and waits for them to finish. The calling thread executes the main-thread tasks
+       *        and helps with the others. After the first exception thrown by a task, the tasks not yet started are
+       *        skipped and the exception is rethrown. The group is empty afterwards.
+       */
+      void wait()
+      {
+        if (mTasks.empty())
+        {
+          return;
+        }
+
+        checkAcyclic();
+
+        ThreadPool& pool = getThreadPool();
+
+        const std::size_t queueCount = pool.getThreadCount();
+
+        mQueues    = std::vector<WorkQueue>(queueCount);
+        mRemaining = mTasks.size();
+        mFailed    = false;
+        mException = nullptr;
+
+        std::size_t next{};
+
+        for (Task& task : mTasks)
+        {
+          task.pending = task.dependencyCount;
+
+          if (task.dependencyCount == 0)
+          {
+            push(task, next++ % queueCount);
+          }
+        }
+
+        const std::thread::id mainThreadId = std::this_thread::get_id();
+
+        pool.run(queueCount, [&](std::size_t i)
+        {
+          participate(i, std::this_thread::get_id() == mainThreadId);
+        });
+
+        // all participants may have been pool workers, finish the main-thread tasks here
+        participate(0, true);
+
+        mTasks.clear();
+        mQueues.clear();
+
+        if (std::exception_ptr exception = std::exchange(mException, nullptr))
+        {
+          std::rethrow_exception(exception);
+        }
+      }
+    private:
+      /// @brief Task of the group.
+      struct Task
+      {
+        std::function<void()>    fn{};              ///< The task function.
+        TaskAffinity             affinity{};        ///< The task affinity.
+        std::vector<TaskId>      successors{};      ///< The tasks depending on this task.
+        std::size_t              dependencyCount{}; ///< The number of tasks this task depends on.
+        std::atomic<std::size_t> pending{};         ///< The number of unfinished dependencies.
+      };
+
+      /// @brief Task queue owned by a participating thread.
+      struct WorkQueue
+      {
+        std::mutex         mutex{}; ///< Protects the queue.
+        std::deque<Task*>  tasks{}; ///< The ready tasks, the owner pops from the back, thieves from the front.
+      };
+
+      /// @brief Checks that the dependency edges do not form a cycle.
+      void checkAcyclic() const
+      {
+        std::vector<std::size_t> pending(mTasks.size());
+        std::vector<TaskId>      ready{};
+
+        for (TaskId id{}; id < mTasks.size(); ++id)
+        {
+          pending[id] = mTasks[id].dependencyCount;
+
+          if (pending[id] == 0)
+          {
+            ready.push_back(id);
+          }
+        }
+
+        std::size_t visited{};
+
+        while (!ready.empty())
+        {
+          const TaskId id = ready.back();
+          ready.pop_back();
+          ++visited;
+
+          for (const TaskId successor : mTasks[id].successors)
+          {
+            if (--pending[successor] == 0)
+            {
+              ready.push_back(successor);
+            }
+          }
+        }
+
+        if (visited != mTasks.size())
+        {
+          throw Exception{"matlabw:mx:TaskGroup:wait", "task dependencies form a cycle"};
+        }
+      }
+
+      /**
+       * @brief Queues a ready task.
+       * @param task The task.
+       * @param queueIndex The index of the queue for tasks without main-thread affinity.
+       */
+      void push(Task& task, std::size_t queueIndex)
+      {
+        WorkQueue& queue = (task.affinity == TaskAffinity::mainThread) ? mMainQueue : mQueues[queueIndex];
+
+        {
+          std::lock_guard lock{queue.mutex};
+          queue.tasks.push_back(&task);
+        }
+
+        mWakeCondition.notify_all();
+      }
+
+      /**
+       * @brief Pops a task from the back of a queue.
+       * @param queue The queue.
+       * @return The task or nullptr if the queue is empty.
+       */
+      [[nodiscard]] static Task* popBack(WorkQueue& queue)
+      {
+        std::lock_guard lock{queue.mutex};
+
+        if (queue.tasks.empty())
+        {
+          return nullptr;
+        }
+
+        Task* task = queue.tasks.back();
+        queue.tasks.pop_back();
+
+        return task;
+      }
+
+      /**
+       * @brief Pops a task from the front of a queue.
+       * @param queue The queue.
+       * @return The task or nullptr if the queue is empty.
+       */
+      [[nodiscard]] static Task* popFront(WorkQueue& queue)
+      {
+        std::lock_guard lock{queue.mutex};
+
+        if (queue.tasks.empty())
+        {
+          return nullptr;
+        }
+
+        Task* task = queue.tasks.front();
+        queue.tasks.pop_front();
+
+        return task;
+      }
+
+      /**
+       * @brief Finds a task for a participating thread.
+       * @param index The index of the thread's queue.
+       * @param isMain True if the thread drains the main-thread tasks.
+       * @return The task or nullptr if there is no ready task.
+       */
+      [[nodiscard]] Task* findTask(std::size_t index, bool isMain)
+      {
+        if (isMain)
+        {
+          if (Task* task = popFront(mMainQueue))
+          {
+            return task;
+          }
+        }
+
+        if (Task* task = popBack(mQueues[index]))
+        {
+          return task;
+        }
+
+        for (std::size_t i = 1; i < mQueues.size(); ++i)
+        {
+          if (Task* task = popFront(mQueues[(index + i) % mQueues.size()]))
+          {
+            return task;
+          }
+        }
+
+        return nullptr;
+      }
+
+      /**
+       * @brief Executes tasks until all tasks of the group have finished.
+       * @param index The index of the thread's queue.
+       * @param isMain True if the thread drains the main-thread tasks.
+       */
+      void participate(std::size_t index, bool isMain)
+      {
+        while (mRemaining.load() != 0)
+        {
+          Task* task = findTask(index, isMain);
+
+          if (task == nullptr)
+          {
+            std::unique_lock lock{mWakeMutex};
+            mWakeCondition.wait_for(lock, std::chrono::microseconds{100});
+            continue;
+          }
+
+          execute(*task, index);
+        }
+      }
+
+      /**
+       * @brief Executes a task and queues its successors that became ready.
+       * @param task The task.
+       * @param index The index of the executing thread's queue.
+       */
+      void execute(Task& task, std::size_t index)
+      {
+        if (!mFailed.load())
+        {
+          try
+          {
+            if (mCancellationToken != nullptr)
+            {
+              mCancellationToken->throwIfCancelled();
+            }
+
+            task.fn();
+          }
+          catch (...)
+          {
+            std::lock_guard lock{mWakeMutex};
+
+            if (!mFailed.exchange(true))
+            {
+              mException = std::current_exception();
+            }
+          }
+        }
+
+        for (const TaskId successor : task.successors)
+        {
+          if (mTasks[successor].pending.fetch_sub(1) == 1)
+          {
+            push(mTasks[successor], index);
+          }
+        }
+
+        if (mRemaining.fetch_sub(1) == 1)
+        {
+          mWakeCondition.notify_all();
+        }
+      }
+
+      std::deque<Task>         mTasks{};             ///< The tasks, deque keeps their addresses stable.
+      std::vector<WorkQueue>   mQueues{};            ///< The queues of the participating threads.
+      WorkQueue                mMainQueue{};         ///< The queue of the main-thread tasks.
+      std::atomic<std::size_t> mRemaining{};         ///< The number of unfinished tasks.
+      std::atomic<bool>        mFailed{};            ///< Set after a task has thrown.
+      std::exception_ptr       mException{};         ///< The first exception thrown by a task.
+      std::mutex               mWakeMutex{};         ///< Mutex of the wake condition.
+      std::condition_variable  mWakeCondition{};     ///< Signals ready tasks and completion.
+      CancellationToken*       mCancellationToken{}; ///< The cancellation token or nullptr.
+  };
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_TASK_GROUP_HPP */
@@ -0,0 +1,327 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_THREAD_POOL_HPP
+#define MATLABW_MX_THREAD_POOL_HPP
+
+#include "detail/include.hpp"
+
+namespace matlabw::mx
+{
+  /**
+   * @brief Fixed-size pool of worker threads executing fork-join jobs. The thread submitting a job takes part in its
+   *        execution and returns once all of its chunks are done. Jobs submitted from a worker thread or while another
+   *        job is running are executed on the calling thread. Jobs must not call into the MATLAB API.
+   */
+  class ThreadPool
+  {
+    public:
+      /**
+       * @brief Constructor.
+       * @param threadCount The total number of threads executing a job, including the calling thread.
+       */
+      explicit ThreadPool(std::size_t threadCount)
+      {
+        const std::size_t workerCount = std::max(threadCount, std::size_t{1}) - 1;
+
+        mWorkers.reserve(workerCount);
+
+        for (std::size_t i{}; i < workerCount; ++i)
+        {
+          mWorkers.emplace_back([this]{ workerLoop(); });
+        }
+      }
+
+      /// @brief Explicitly deleted copy constructor.
+      ThreadPool(const ThreadPool&) = delete;
+
+      /// @brief Explicitly deleted move constructor.
+      ThreadPool(ThreadPool&&) = delete;
+
+      /// @brief Destructor. Stops and joins the worker threads.
+      ~ThreadPool() noexcept
+      {
+        {
+          std::lock_guard lock{mMutex};
+          mStop = true;
+        }
+
+        mWakeCondition.notify_all();
+
+        for (auto& worker : mWorkers)
+        {
+          worker.join();
+        }
+      }
+
+      /// @brief Explicitly deleted copy assignment operator.
+      ThreadPool& operator=(const ThreadPool&) = delete;
+
+      /// @brief Explicitly deleted move assignment operator.
+      ThreadPool& operator=(ThreadPool&&) = delete;
+
+      /**
+       * @brief Gets the total number of threads executing a job, including the calling thread.
+       * @return The number of threads.
+       */
+      [[nodiscard]] std::size_t getThreadCount() const noexcept
+      {
+        return mWorkers.size() + 1;
+      }
+
+      /**
+       * @brief Calls fn(i) for each chunk index i in [0, chunkCount) on the pool threads and waits for completion.
+       *        The first exception thrown by fn is rethrown after all chunks have finished.
+       * @tparam Fn The callable type.
+       * @param chunkCount The number of chunks.
+       * @param fn The callable.
+       */
+      template<typename Fn>
+      void run(std::size_t chunkCount, Fn&& fn)
+      {
+        std::unique_lock jobLock{mJobMutex, std::try_to_lock};
+
+        if (chunkCount <= 1 || mWorkers.empty() || isWorkerThread() || !jobLock.owns_lock())
+        {
+          for (std::size_t i{}; i < chunkCount; ++i)
+          {
+            fn(i);
+          }
+
+          return;
+        }
+
+        auto invoke = [](void* context, std::size_t i)
+        {
+          (*static_cast<std::remove_reference_t<Fn>*>(context))(i);
+        };
+
+        const Job job{invoke, std::addressof(fn), chunkCount};
+
+        {
+          // wait for workers that woke up late for the previous job
+          std::unique_lock lock{mMutex};
+          mDoneCondition.wait(lock, [this]{ return mActiveCount == 0; });
+
+          mJob          = job;
+          mNextChunk    = 0;
+          mPendingCount = chunkCount;
+          mException    = nullptr;
+          ++mGeneration;
+        }
+
+        mWakeCondition.notify_all();
+
+        execute(job);
+
+        std::unique_lock lock{mMutex};
+        mDoneCondition.wait(lock, [this]{ return mPendingCount == 0 && mActiveCount == 0; });
+
+        if (std::exception_ptr exception = std::exchange(mException, nullptr))
+        {
+          std::rethrow_exception(exception);
+        }
+      }
+    private:
+      /// @brief Type-erased job.
+      struct Job
+      {
+        void        (*invoke)(void*, std::size_t){}; ///< Invokes the callable for a chunk.
+        void*       context{};                        ///< The callable.
+        std::size_t chunkCount{};                     ///< The number of chunks.
+      };
+
+      /**
+       * @brief Gets the flag marking pool threads.
+       * @return Reference to the thread-local flag.
+       */
+      [[nodiscard]] static bool& getWorkerFlag() noexcept
+      {
+        thread_local bool isWorker{};
+        return isWorker;
+      }
+
+      /**
+       * @brief Checks if the calling thread is executing a job.
+       * @return True if the calling thread is a worker or is executing a job, false otherwise.
+       */
+      [[nodiscard]] static bool isWorkerThread() noexcept
+      {
+        return getWorkerFlag();
+      }
+
+      /**
+       * @brief Claims and executes chunks of the current job until none are left.
+       * @param job The current job.
+       */
+      void execute(const Job& job)
+      {
+        const bool wasWorker = std::exchange(getWorkerFlag(), true);
+
+        for (std::size_t i = mNextChunk.fetch_add(1); i < job.chunkCount; i = mNextChunk.fetch_add(1))
+        {
+          try
+          {
+            job.invoke(job.context, i);
+          }
+          catch (...)
+          {
+            std::lock_guard lock{mMutex};
+
+            if (!mException)
+            {
+              mException = std::current_exception();
+            }
+          }
+
+          std::lock_guard lock{mMutex};
+
+          if (--mPendingCount == 0)
+          {
+            mDoneCondition.notify_all();
+          }
+        }
+
+        getWorkerFlag() = wasWorker;
+      }
+
+      /// @brief Main loop of the worker threads.
+      void workerLoop()
+      {
+        getWorkerFlag() = true;
+
+        std::uint64_t generation{};
+
+        while (true)
+        {
+          Job job{};
+
+          {
+            std::unique_lock lock{mMutex};
+            mWakeCondition.wait(lock, [&]{ return mStop || mGeneration != generation; });
+
+            if (mStop)
+            {
+              return;
+            }
+
+            generation = mGeneration;
+            job        = mJob;
+            ++mActiveCount;
+          }
+
+          execute(job);
+
+          std::lock_guard lock{mMutex};
+
+          if (--mActiveCount == 0)
+          {
+            mDoneCondition.notify_all();
+          }
+        }
+      }
+
+      std::vector<std::thread>   mWorkers{};       ///< The worker threads.
+      std::mutex                 mJobMutex{};      ///< Serializes job submission.
+      std::mutex                 mMutex{};         ///< Protects the job state.
+      std::condition_variable    mWakeCondition{}; ///< Signals a new job or stop to the workers.
+      std::condition_variable    mDoneCondition{}; ///< Signals job completion to the submitting thread.
+      Job                        mJob{};           ///< The current job.
+      std::atomic<std::size_t>   mNextChunk{};     ///< The next chunk to be claimed.
+      std::size_t                mPendingCount{};  ///< The number of chunks not yet finished.
+      std::size_t                mActiveCount{};   ///< The number of workers executing the current job.
+      std::uint64_t              mGeneration{};    ///< Incremented with each job.
+      std::exception_ptr         mException{};     ///< The first exception thrown by the current job.
+      bool                       mStop{};          ///< Requests the workers to stop.
+  };
+
+  namespace detail
+  {
+    /// @brief Customization of the shared thread pool installed by the MEX layer.
+    struct ThreadPoolHooks
+    {
+      std::size_t (*getThreadCount)(){}; ///< Provides the number of threads, hardware concurrency if null.
+      void        (*onCreate)(){};       ///< Called after the shared thread pool has been created.
+    };
+
+    /**
+     * @brief Gets the hooks of the shared thread pool.
+     * @return The hooks.
+     */
+    [[nodiscard]] inline ThreadPoolHooks& getThreadPoolHooks() noexcept
+    {
+      static ThreadPoolHooks hooks{};
+
+      return hooks;
+    }
+
+    /**
+     * @brief Gets the storage of the shared thread pool.
+     * @return The storage.
+     */
+    [[nodiscard]] inline std::unique_ptr<ThreadPool>& getThreadPoolStorage() noexcept
+    {
+      static std::unique_ptr<ThreadPool> pool{};
+
+      return pool;
+    }
+  } // namespace detail
+
+  /**
+   * @brief Gets the thread pool shared by all parallel algorithms. The pool is created on first use, which must
+   *        happen on the thread that calls into the MATLAB API. Inside MEX functions the pool follows MATLAB's
+   *        computational thread count and lives across calls.
+   * @return The thread pool.
+   */
+  [[nodiscard]] inline ThreadPool& getThreadPool()
+  {
+    auto& pool = detail::getThreadPoolStorage();
+
+    if (!pool)
+    {
+      const auto& hooks = detail::getThreadPoolHooks();
+
+      const std::size_t threadCount = (hooks.getThreadCount != nullptr)
+                                    ? hooks.getThreadCount()
+                                    : static_cast<std::size_t>(std::thread::hardware_concurrency());
+
+      pool = std::make_unique<ThreadPool>(threadCount);
+
+      if (hooks.onCreate != nullptr)
+      {
+        hooks.onCreate();
+      }
+    }
+
+    return *pool;
+  }
+
+  /// @brief Destroys the shared thread pool and joins its threads. The next use creates a new pool.
+  inline void resetThreadPool() noexcept
+  {
+    detail::getThreadPoolStorage().reset();
+  }
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_THREAD_POOL_HPP */
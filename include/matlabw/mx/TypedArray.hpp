@@ -29,6 +29,7 @@
 
 #include "Array.hpp"
 #include "common.hpp"
+#include "memory.hpp"
 #include "TypedArrayRef.hpp"
 
 namespace matlabw::mx
@@ -167,6 +168,49 @@ namespace matlabw::mx
         return static_cast<const_pointer>(Array::getData());
       }
 
+      /**
+       * @brief Replaces the array data with a buffer allocated by mx::malloc or mx::calloc without copying. The
+       *        previous data is freed and the array takes ownership of the buffer.
+       * @param data Buffer holding at least as many elements as the new dimensions describe
+       * @param dims New dimensions
+       */
+      void replaceData(std::unique_ptr<T[], Deleter> data, View<std::size_t> dims)
+        requires (mx::isNumeric<T> || std::is_same_v<T, bool> || std::is_same_v<T, char16_t>)
+      {
+        checkValid("matlabw:mx:TypedArray:replaceData");
+
+        const std::size_t size = std::accumulate(dims.begin(), dims.end(), std::size_t{1}, std::multiplies<>{});
+
+        if (data == nullptr && size != 0)
+        {
+          throw Exception{"matlabw:mx:TypedArray:replaceData", "null data for non-empty dimensions"};
+        }
+
+        resize(dims);
+
+        free(Array::getData());
+        mxSetData(get(), data.release());
+      }
+
+      /**
+       * @brief Replaces the array data with a buffer allocated by mx::malloc or mx::calloc without copying. The
+       *        dimensions are kept.
+       * @param data Buffer holding at least getSize() elements
+       */
+      void replaceData(std::unique_ptr<T[], Deleter> data)
+        requires (mx::isNumeric<T> || std::is_same_v<T, bool> || std::is_same_v<T, char16_t>)
+      {
+        checkValid("matlabw:mx:TypedArray:replaceData");
+
+        if (data == nullptr && getSize() != 0)
+        {
+          throw Exception{"matlabw:mx:TypedArray:replaceData", "null data for non-empty array"};
+        }
+
+        free(Array::getData());
+        mxSetData(get(), data.release());
+      }
+
       /**
        * @brief Gets the element at the specified index
        * @param i Index
@@ -325,6 +369,52 @@ namespace matlabw::mx
         return const_reverse_iterator{begin()};
       }
 
+      /**
+       * @brief Gets a column-major multidimensional span of the array with dynamic extents.
+       * @tparam rank The rank of the mdspan.
+       * @return The multidimensional span.
+       */
+      template<std::size_t rank>
+      [[nodiscard]] Mdspan<T, Dextents<rank>> asMdspan()
+      {
+        return asMdspan<Dextents<rank>>();
+      }
+
+      /**
+       * @brief Gets a column-major multidimensional span of the array. Static extents are checked against the array
+       *        dimensions.
+       * @tparam E The extents type.
+       * @return The multidimensional span.
+       */
+      template<typename E>
+      [[nodiscard]] Mdspan<T, E> asMdspan()
+      {
+        return Mdspan<T, E>{getData(), detail::makeExtents<E>(getDims())};
+      }
+
+      /**
+       * @brief Gets a column-major multidimensional span of the array with dynamic extents.
+       * @tparam rank The rank of the mdspan.
+       * @return The multidimensional span.
+       */
+      template<std::size_t rank>
+      [[nodiscard]] Mdview<T, Dextents<rank>> asMdspan() const
+      {
+        return asMdspan<Dextents<rank>>();
+      }
+
+      /**
+       * @brief Gets a column-major multidimensional span of the array. Static extents are checked against the array
+       *        dimensions.
+       * @tparam E The extents type.
+       * @return The multidimensional span.
+       */
+      template<typename E>
+      [[nodiscard]] Mdview<T, E> asMdspan() const
+      {
+        return Mdview<T, E>{getData(), detail::makeExtents<E>(getDims())};
+      }
+
       /// @brief Use the Array::operator ArrayRef
       using Array::operator ArrayRef;
 
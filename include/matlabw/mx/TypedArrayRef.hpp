@@ -29,6 +29,7 @@
 
 #include "ArrayRef.hpp"
 #include "common.hpp"
+#include "mdspan.hpp"
 
 namespace matlabw::mx
 {
@@ -42,6 +43,8 @@ namespace detail
   template<ClassId classId>
   void checkArrayClass(const mxArray* array)
   {
+    checkThread("matlabw:mx:checkArrayClass");
+
     if (array == nullptr)
     {
       throw Exception{"invalid array"};
@@ -52,6 +55,15 @@ namespace detail
       throw Exception{"invalid array class"};
     }
   }
+
+  /// @brief Tag type selecting the typed reference constructors that skip the class check.
+  struct UncheckedTag
+  {
+    explicit UncheckedTag() = default;
+  };
+
+  /// @brief Tag value selecting the typed reference constructors that skip the class check.
+  inline constexpr UncheckedTag unchecked{};
 } // namespace detail
 
   /**
@@ -216,6 +228,29 @@ namespace detail
       {
         return const_reverse_iterator{begin()};
       }
+
+      /**
+       * @brief Gets a column-major multidimensional span of the array with dynamic extents.
+       * @tparam rank The rank of the mdspan.
+       * @return The multidimensional span.
+       */
+      template<std::size_t rank>
+      [[nodiscard]] Mdspan<T, Dextents<rank>> asMdspan() const
+      {
+        return asMdspan<Dextents<rank>>();
+      }
+
+      /**
+       * @brief Gets a column-major multidimensional span of the array. Static extents are checked against the array
+       *        dimensions.
+       * @tparam E The extents type.
+       * @return The multidimensional span.
+       */
+      template<typename E>
+      [[nodiscard]] Mdspan<T, E> asMdspan() const
+      {
+        return Mdspan<T, E>{getData(), detail::makeExtents<E>(getDims())};
+      }
     private:
       /// @brief Checks if the array is of the correct class
       void checkArrayClass(const mxArray* array) const
@@ -275,6 +310,14 @@ namespace detail
       : ArrayCref{(checkArrayClass(other.get()), other)}
       {}
 
+      /**
+       * @brief Constructor from an ArrayCref whose class has already been checked by the caller.
+       * @param other ArrayCref
+       */
+      TypedArrayCref(const ArrayCref& other, detail::UncheckedTag) noexcept
+      : ArrayCref{other}
+      {}
+
       /**
        * @brief Constructor from a ArrayCref.
        * @param other ArrayCref
@@ -400,6 +443,29 @@ namespace detail
       {
         return rend();
       }
+
+      /**
+       * @brief Gets a column-major multidimensional span of the array with dynamic extents.
+       * @tparam rank The rank of the mdspan.
+       * @return The multidimensional span.
+       */
+      template<std::size_t rank>
+      [[nodiscard]] Mdview<T, Dextents<rank>> asMdspan() const
+      {
+        return asMdspan<Dextents<rank>>();
+      }
+
+      /**
+       * @brief Gets a column-major multidimensional span of the array. Static extents are checked against the array
+       *        dimensions.
+       * @tparam E The extents type.
+       * @return The multidimensional span.
+       */
+      template<typename E>
+      [[nodiscard]] Mdview<T, E> asMdspan() const
+      {
+        return Mdview<T, E>{getData(), detail::makeExtents<E>(getDims())};
+      }
     private:
       /// @brief Checks if the array is of the correct class
       void checkArrayClass(const mxArray* array) const
@@ -0,0 +1,355 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_TYPED_ARRAY_SNAPSHOT_HPP
+#define MATLABW_MX_TYPED_ARRAY_SNAPSHOT_HPP
+
+#include "detail/include.hpp"
+
+#include "common.hpp"
+#include "Exception.hpp"
+#include "TypedArray.hpp"
+#include "TypedArrayRef.hpp"
+
+namespace matlabw::mx
+{
+  /**
+   * @brief Typed array snapshot class. Caches the data pointer, rank, dimensions and number of elements of an array,
+   *        so the element access does not query the MATLAB API. The snapshot is invalidated when the array is
+   *        resized, its data is replaced or the array is destroyed.
+   * @tparam T Value type, const qualified for read-only snapshots
+   */
+  template<typename T>
+  class TypedArraySnapshot
+  {
+    static_assert(!std::is_volatile_v<T>, "T must be a non-volatile type");
+    static_assert(!std::is_reference_v<T>, "T must be a non-reference type");
+
+    public:
+      using value_type             = T;                                     ///< Value type
+      using reference              = value_type&;                           ///< Reference type
+      using const_reference        = const value_type&;                     ///< Const reference type
+      using pointer                = value_type*;                           ///< Pointer type
+      using const_pointer          = const value_type*;                     ///< Const pointer type
+      using iterator               = pointer;                               ///< Iterator type
+      using const_iterator         = const_pointer;                         ///< Const iterator type
+      using reverse_iterator       = std::reverse_iterator<iterator>;       ///< Reverse iterator type
+      using const_reverse_iterator = std::reverse_iterator<const_iterator>; ///< Const reverse iterator type
+
+      /// @brief Class ID
+      static constexpr ClassId classId = TypeProperties<T>::classId;
+
+      /// @brief Explicitly deleted default constructor.
+      TypedArraySnapshot() = delete;
+
+      /**
+       * @brief Constructor from a TypedArrayRef.
+       * @param array Typed array reference
+       */
+      explicit TypedArraySnapshot(const TypedArrayRef<std::remove_const_t<T>>& array)
+      : TypedArraySnapshot{array.getData(), array.getDims()}
+      {}
+
+      /**
+       * @brief Constructor from a TypedArrayCref. Only available for read-only snapshots.
+       * @param array Typed array const reference
+       */
+      explicit TypedArraySnapshot(const TypedArrayCref<std::remove_const_t<T>>& array) requires std::is_const_v<T>
+      : TypedArraySnapshot{array.getData(), array.getDims()}
+      {}
+
+      /**
+       * @brief Constructor from a TypedArray.
+       * @param array Typed array
+       */
+      explicit TypedArraySnapshot(TypedArray<std::remove_const_t<T>>& array)
+      : TypedArraySnapshot{array.getData(), array.getDims()}
+      {}
+
+      /**
+       * @brief Constructor from a const TypedArray. Only available for read-only snapshots.
+       * @param array Typed array
+       */
+      explicit TypedArraySnapshot(const TypedArray<std::remove_const_t<T>>& array) requires std::is_const_v<T>
+      : TypedArraySnapshot{array.getData(), array.getDims()}
+      {}
+
+      /**
+       * @brief Copy constructor.
+       * @param other Other snapshot
+       */
+      TypedArraySnapshot(const TypedArraySnapshot& other) = default;
+
+      /**
+       * @brief Conversion constructor from a mutable snapshot to a read-only snapshot.
+       * @param other Other snapshot
+       */
+      TypedArraySnapshot(const TypedArraySnapshot<std::remove_const_t<T>>& other) requires std::is_const_v<T>
+      : mData{other.getData()}, mDims{other.getDims()}, mSize{other.getSize()}
+      {}
+
+      /// @brief Destructor.
+      ~TypedArraySnapshot() = default;
+
+      /**
+       * @brief Copy assignment operator.
+       * @param other Other snapshot
+       * @return Reference to this snapshot
+       */
+      TypedArraySnapshot& operator=(const TypedArraySnapshot& other) = default;
+
+      /**
+       * @brief Gets the rank of the array.
+       * @return The rank of the array
+       */
+      [[nodiscard]] std::size_t getRank() const noexcept
+      {
+        return mDims.size();
+      }
+
+      /**
+       * @brief Gets the dimensions of the array.
+       * @return The dimensions of the array
+       */
+      [[nodiscard]] View<std::size_t> getDims() const noexcept
+      {
+        return mDims;
+      }
+
+      /**
+       * @brief Get the number of rows
+       * @return Number of rows
+       */
+      [[nodiscard]] std::size_t getDimM() const noexcept
+      {
+        return mDims[0];
+      }
+
+      /**
+       * @brief Get the number of columns. Trailing dimensions are collapsed into the columns as in mxGetN.
+       * @return Number of columns
+       */
+      [[nodiscard]] std::size_t getDimN() const noexcept
+      {
+        return (mDims[0] != 0) ? mSize / mDims[0] : std::accumulate(std::next(mDims.begin()),
+                                                                    mDims.end(),
+                                                                    std::size_t{1},
+                                                                    std::multiplies<>{});
+      }
+
+      /**
+       * @brief Gets the number of elements in the array.
+       * @return The number of elements in the array
+       */
+      [[nodiscard]] std::size_t getSize() const noexcept
+      {
+        return mSize;
+      }
+
+      /**
+       * @brief Is the array empty?
+       * @return True if the array is empty, false otherwise
+       */
+      [[nodiscard]] bool isEmpty() const noexcept
+      {
+        return mSize == 0;
+      }
+
+      /**
+       * @brief Is the array a scalar?
+       * @return True if the array is a scalar, false otherwise
+       */
+      [[nodiscard]] bool isScalar() const noexcept
+      {
+        return mSize == 1;
+      }
+
+      /**
+       * @brief Gets a pointer to the data.
+       * @return Pointer to the data
+       */
+      [[nodiscard]] pointer getData() const noexcept
+      {
+        return mData;
+      }
+
+      /**
+       * @brief Gets the data as a span.
+       * @return Span of the data
+       */
+      [[nodiscard]] Span<T> getSpan() const noexcept
+      {
+        return Span<T>{mData, mSize};
+      }
+
+      /**
+       * @brief Accesses an element with bounds checking.
+       * @param i Index
+       * @return Reference to the element
+       */
+      [[nodiscard]] reference at(std::size_t i) const
+      {
+        if (i >= mSize)
+        {
+          throw Exception{"matlabw:mx:TypedArraySnapshot:at", "index out of range"};
+        }
+
+        return mData[i];
+      }
+
+      /**
+       * @brief Accesses an element without bounds checking.
+       * @param i Index
+       * @return Reference to the element
+       */
+      [[nodiscard]] reference operator[](std::size_t i) const noexcept
+      {
+        return mData[i];
+      }
+
+      /**
+       * @brief Gets an iterator to the beginning.
+       * @return Iterator to the beginning
+       */
+      [[nodiscard]] iterator begin() const noexcept
+      {
+        return mData;
+      }
+
+      /**
+       * @brief Gets a const iterator to the beginning.
+       * @return Const iterator to the beginning
+       */
+      [[nodiscard]] const_iterator cbegin() const noexcept
+      {
+        return mData;
+      }
+
+      /**
+       * @brief Gets an iterator to the end.
+       * @return Iterator to the end
+       */
+      [[nodiscard]] iterator end() const noexcept
+      {
+        return mData + mSize;
+      }
+
+      /**
+       * @brief Gets a const iterator to the end.
+       * @return Const iterator to the end
+       */
+      [[nodiscard]] const_iterator cend() const noexcept
+      {
+        return mData + mSize;
+      }
+
+      /**
+       * @brief Gets a reverse iterator to the beginning.
+       * @return Reverse iterator to the beginning
+       */
+      [[nodiscard]] reverse_iterator rbegin() const noexcept
+      {
+        return reverse_iterator{end()};
+      }
+
+      /**
+       * @brief Gets a const reverse iterator to the beginning.
+       * @return Const reverse iterator to the beginning
+       */
+      [[nodiscard]] const_reverse_iterator crbegin() const noexcept
+      {
+        return const_reverse_iterator{cend()};
+      }
+
+      /**
+       * @brief Gets a reverse iterator to the end.
+       * @return Reverse iterator to the end
+       */
+      [[nodiscard]] reverse_iterator rend() const noexcept
+      {
+        return reverse_iterator{begin()};
+      }
+
+      /**
+       * @brief Gets a const reverse iterator to the end.
+       * @return Const reverse iterator to the end
+       */
+      [[nodiscard]] const_reverse_iterator crend() const noexcept
+      {
+        return const_reverse_iterator{cbegin()};
+      }
+    private:
+      /**
+       * @brief Constructor from the data pointer and dimensions.
+       * @param data Data pointer
+       * @param dims Dimensions
+       */
+      TypedArraySnapshot(pointer data, View<std::size_t> dims)
+      : mData{data},
+        mDims{dims},
+        mSize{std::accumulate(dims.begin(), dims.end(), std::size_t{1}, std::multiplies<>{})}
+      {}
+
+      pointer           mData{}; ///< Data pointer
+      View<std::size_t> mDims{}; ///< Dimensions
+      std::size_t       mSize{}; ///< Number of elements
+  };
+
+  /**
+   * @brief Deduction guide for a snapshot of TypedArrayRef.
+   * @tparam T Value type
+   */
+  template<typename T>
+  TypedArraySnapshot(const TypedArrayRef<T>&) -> TypedArraySnapshot<T>;
+
+  /**
+   * @brief Deduction guide for a snapshot of TypedArrayCref.
+   * @tparam T Value type
+   */
+  template<typename T>
+  TypedArraySnapshot(const TypedArrayCref<T>&) -> TypedArraySnapshot<const T>;
+
+  /**
+   * @brief Deduction guide for a snapshot of TypedArray.
+   * @tparam T Value type
+   */
+  template<typename T>
+  TypedArraySnapshot(TypedArray<T>&) -> TypedArraySnapshot<T>;
+
+  /**
+   * @brief Deduction guide for a snapshot of const TypedArray.
+   * @tparam T Value type
+   */
+  template<typename T>
+  TypedArraySnapshot(const TypedArray<T>&) -> TypedArraySnapshot<const T>;
+
+  /**
+   * @brief Numeric typed array snapshot
+   * @tparam T Element type
+   */
+  template<typename T, std::enable_if_t<isNumeric<T>, int> = 0>
+  using NumericArraySnapshot = TypedArraySnapshot<T>;
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_TYPED_ARRAY_SNAPSHOT_HPP */
@@ -0,0 +1,515 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_CELLSTR_HPP
+#define MATLABW_MX_CELLSTR_HPP
+
+#include "detail/include.hpp"
+#include "detail/parallel.hpp"
+
+#include "Arena.hpp"
+#include "CellArray.hpp"
+#include "CellArrayRef.hpp"
+#include "Exception.hpp"
+#include "threadCheck.hpp"
+
+namespace matlabw::mx
+{
+namespace detail
+{
+  /// @brief Code point emitted for invalid UTF-16 or UTF-8 sequences.
+  inline constexpr char32_t replacementCharacter{0xFFFD};
+
+  /**
+   * @brief Encodes a code point as UTF-8.
+   * @tparam store If false, only the length is computed and dst is not accessed.
+   * @param c The code point.
+   * @param dst The destination.
+   * @return The number of bytes.
+   */
+  template<bool store>
+  std::size_t encodeUtf8(char32_t c, [[maybe_unused]] char* dst) noexcept
+  {
+    if (c < 0x80)
+    {
+      if constexpr (store)
+      {
+        dst[0] = static_cast<char>(c);
+      }
+
+      return 1;
+    }
+    else if (c < 0x800)
+    {
+      if constexpr (store)
+      {
+        dst[0] = static_cast<char>(0xC0 | (c >> 6));
+        dst[1] = static_cast<char>(0x80 | (c & 0x3F));
+      }
+
+      return 2;
+    }
+    else if (c < 0x10000)
+    {
+      if constexpr (store)
+      {
+        dst[0] = static_cast<char>(0xE0 | (c >> 12));
+        dst[1] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        dst[2] = static_cast<char>(0x80 | (c & 0x3F));
+      }
+
+      return 3;
+    }
+    else
+    {
+      if constexpr (store)
+      {
+        dst[0] = static_cast<char>(0xF0 | (c >> 18));
+        dst[1] = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+        dst[2] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        dst[3] = static_cast<char>(0x80 | (c & 0x3F));
+      }
+
+      return 4;
+    }
+  }
+
+  /**
+   * @brief Transcodes UTF-16 to UTF-8. Runs of ASCII characters are converted with SIMD, unpaired surrogates are
+   *        replaced by U+FFFD.
+   * @tparam store If false, only the length of the result is computed and dst is not accessed.
+   * @param src The UTF-16 source.
+   * @param dst The UTF-8 destination, it must hold the length computed with store set to false.
+   * @return The number of UTF-8 bytes.
+   */
+  template<bool store>
+  std::size_t utf16ToUtf8(std::u16string_view src, [[maybe_unused]] char* dst) noexcept
+  {
+    const std::size_t n = src.size();
+    const char16_t*   s = src.data();
+
+    std::size_t i{};
+    std::size_t j{};
+
+    while (i < n)
+    {
+#   if defined(MATLABW_HAS_AVX2)
+      for (; i + 16 <= n; i += 16, j += 16)
+      {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+
+        if (!_mm256_testz_si256(v, _mm256_set1_epi16(static_cast<short>(0xFF80))))
+        {
+          break;
+        }
+
+        if constexpr (store)
+        {
+          const __m128i r = _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j), r);
+        }
+      }
+#   elif defined(MATLABW_HAS_SSE2)
+      for (; i + 8 <= n; i += 8, j += 8)
+      {
+        const __m128i v     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(static_cast<short>(0xFF80))),
+                                              _mm_setzero_si128());
+
+        if (_mm_movemask_epi8(ascii) != 0xFFFF)
+        {
+          break;
+        }
+
+        if constexpr (store)
+        {
+          _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + j), _mm_packus_epi16(v, v));
+        }
+      }
+#   endif
+
+      if (i == n)
+      {
+        break;
+      }
+
+      // one code point, then back to the vector loop
+      char32_t c = s[i++];
+
+      if (c >= 0xD800 && c <= 0xDFFF)
+      {
+        if (c <= 0xDBFF && i < n && s[i] >= 0xDC00 && s[i] <= 0xDFFF)
+        {
+          c = 0x10000 + ((c - 0xD800) << 10) + (s[i++] - 0xDC00);
+        }
+        else
+        {
+          c = replacementCharacter;
+        }
+      }
+
+      if constexpr (store)
+      {
+        j += encodeUtf8<true>(c, dst + j);
+      }
+      else
+      {
+        j += encodeUtf8<false>(c, nullptr);
+      }
+    }
+
+    return j;
+  }
+
+  /**
+   * @brief Transcodes UTF-8 to UTF-16. Runs of ASCII characters are converted with SIMD, invalid, overlong and
+   *        truncated sequences are replaced by U+FFFD one byte at a time.
+   * @tparam store If false, only the length of the result is computed and dst is not accessed.
+   * @param src The UTF-8 source.
+   * @param dst The UTF-16 destination, it must hold the length computed with store set to false.
+   * @return The number of UTF-16 code units.
+   */
+  template<bool store>
+  std::size_t utf8ToUtf16(std::string_view src, [[maybe_unused]] char16_t* dst) noexcept
+  {
+    static constexpr char32_t minimum[]{0, 0x80, 0x800, 0x10000};
+
+    const std::size_t    n = src.size();
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(src.data());
+
+    std::size_t i{};
+    std::size_t j{};
+
+    while (i < n)
+    {
+#   if defined(MATLABW_HAS_AVX2)
+      for (; i + 32 <= n; i += 32, j += 32)
+      {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+
+        if (_mm256_movemask_epi8(v) != 0)
+        {
+          break;
+        }
+
+        if constexpr (store)
+        {
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + j),      _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + j + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+        }
+      }
+#   elif defined(MATLABW_HAS_SSE2)
+      for (; i + 16 <= n; i += 16, j += 16)
+      {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+
+        if (_mm_movemask_epi8(v) != 0)
+        {
+          break;
+        }
+
+        if constexpr (store)
+        {
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j),     _mm_unpacklo_epi8(v, _mm_setzero_si128()));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j + 8), _mm_unpackhi_epi8(v, _mm_setzero_si128()));
+        }
+      }
+#   endif
+
+      if (i == n)
+      {
+        break;
+      }
+
+      // one code point, then back to the vector loop
+      const unsigned char lead = s[i];
+
+      char32_t c = lead;
+
+      if (lead >= 0x80)
+      {
+        const std::size_t count = (lead >= 0xF0) ? 3 : (lead >= 0xE0) ? 2 : (lead >= 0xC0) ? 1 : 0;
+
+        bool valid = count != 0 && lead < 0xF8 && i + count < n;
+
+        c = lead & (0x3F >> count);
+
+        for (std::size_t k{1}; valid && k <= count; ++k)
+        {
+          valid = (s[i + k] & 0xC0) == 0x80;
+          c     = (c << 6) | (s[i + k] & 0x3F);
+        }
+
+        if (valid && c >= minimum[count] && c <= 0x10FFFF && (c < 0xD800 || c > 0xDFFF))
+        {
+          i += count;
+        }
+        else
+        {
+          c = replacementCharacter;
+        }
+      }
+
+      ++i;
+
+      if (c >= 0x10000)
+      {
+        if constexpr (store)
+        {
+          dst[j]     = static_cast<char16_t>(0xD800 + ((c - 0x10000) >> 10));
+          dst[j + 1] = static_cast<char16_t>(0xDC00 + ((c - 0x10000) & 0x3FF));
+        }
+
+        j += 2;
+      }
+      else
+      {
+        if constexpr (store)
+        {
+          dst[j] = static_cast<char16_t>(c);
+        }
+
+        ++j;
+      }
+    }
+
+    return j;
+  }
+
+  /**
+   * @brief Gets the contents of a cell array of character row vectors. Empty character arrays are accepted as empty
+   *        strings.
+   * @param cells The cell array.
+   * @param id The error ID.
+   * @return Views of the UTF-16 contents.
+   */
+  [[nodiscard]] inline std::vector<std::u16string_view> getCellStrings(CellArrayCref cells, const char* id)
+  {
+    checkThread(id);
+
+    const std::size_t count = cells.getSize();
+
+    std::vector<std::u16string_view> strings(count);
+
+    for (std::size_t i{}; i < count; ++i)
+    {
+      const mxArray* value = mxGetCell(cells.get(), i);
+
+      if (value == nullptr
+          || !mxIsChar(value)
+          || (!mxIsEmpty(value) && (mxGetNumberOfDimensions(value) > 2 || mxGetM(value) != 1)))
+      {
+        throw Exception{id, "element " + std::to_string(i + 1) + " must be a character row vector"};
+      }
+
+      strings[i] = std::u16string_view{static_cast<const char16_t*>(mxGetData(value)), mxGetNumberOfElements(value)};
+    }
+
+    return strings;
+  }
+
+  /**
+   * @brief Gets the parallelization threshold for a conversion of strings.
+   * @param count The number of strings.
+   * @param totalSize The total number of characters.
+   * @return The threshold in strings.
+   */
+  [[nodiscard]] inline std::size_t getStringThreshold(std::size_t count, std::size_t totalSize) noexcept
+  {
+    const std::size_t averageSize = totalSize / std::max<std::size_t>(count, 1);
+
+    return std::max<std::size_t>(parallelThreshold / std::max<std::size_t>(averageSize, 1), 1);
+  }
+
+  /**
+   * @brief Creates an Nx1 cell array of character row vectors from UTF-8 strings.
+   * @tparam Strings The string range type, its elements must convert to std::string_view.
+   * @param strings The strings.
+   * @return The cell array.
+   */
+  template<typename Strings>
+  [[nodiscard]] CellArray makeCellStr(const Strings& strings)
+  {
+    static constexpr char id[]{"matlabw:mx:makeCellStr"};
+
+    checkThread(id);
+
+    const std::size_t count = std::size(strings);
+
+    const std::size_t totalSize = std::accumulate(std::begin(strings), std::end(strings), std::size_t{},
+                                                  [](std::size_t sum, std::string_view str)
+    {
+      return sum + str.size();
+    });
+
+    const std::size_t threshold = getStringThreshold(count, totalSize);
+
+    std::vector<std::size_t> lengths(count);
+
+    parallelFor<std::size_t>(count, [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        lengths[i] = utf8ToUtf16<false>(strings[i], nullptr);
+      }
+    }, threshold);
+
+    CellArray cells = makeCellArray(count, 1);
+
+    std::vector<char16_t*> targets(count);
+
+    // the cell array owns the strings as soon as they are set, the fill below only writes their data
+    for (std::size_t i{}; i < count; ++i)
+    {
+      const std::size_t dims[]{(lengths[i] != 0) ? std::size_t{1} : std::size_t{0}, lengths[i]};
+
+      mxArray* value = mxCreateCharArray(2, dims);
+
+      if (value == nullptr)
+      {
+        throw Exception{id, "failed to create char array"};
+      }
+
+      targets[i] = static_cast<char16_t*>(mxGetData(value));
+
+      mxSetCell(cells.get(), i, value);
+    }
+
+    parallelFor<char16_t*>(count, [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        utf8ToUtf16<true>(strings[i], targets[i]);
+      }
+    }, threshold);
+
+    return cells;
+  }
+} // namespace detail
+
+  /**
+   * @brief Converts a cell array of character row vectors to UTF-8 strings. The strings are converted in parallel.
+   * @param cells The cell array, empty character arrays are converted to empty strings.
+   * @return The strings in column-major order.
+   */
+  [[nodiscard]] inline std::vector<std::string> toStrings(CellArrayCref cells)
+  {
+    const std::vector<std::u16string_view> sources = detail::getCellStrings(cells, "matlabw:mx:toStrings");
+
+    const std::size_t totalSize = std::accumulate(sources.begin(), sources.end(), std::size_t{},
+                                                  [](std::size_t sum, std::u16string_view str)
+    {
+      return sum + str.size();
+    });
+
+    std::vector<std::string> strings(sources.size());
+
+    detail::parallelFor<std::string>(sources.size(), [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        strings[i].resize(detail::utf16ToUtf8<false>(sources[i], nullptr));
+
+        detail::utf16ToUtf8<true>(sources[i], strings[i].data());
+      }
+    }, detail::getStringThreshold(sources.size(), totalSize));
+
+    return strings;
+  }
+
+  /**
+   * @brief Converts a cell array of character row vectors to UTF-8 strings stored in a single allocation from an
+   *        arena. The lengths are computed first, then the strings are converted in parallel.
+   * @param cells The cell array, empty character arrays are converted to empty strings.
+   * @param arena The arena holding the characters, it must outlive the returned views.
+   * @return Views of the strings in column-major order.
+   */
+  [[nodiscard]] inline std::vector<std::string_view> toStrings(CellArrayCref cells, Arena& arena)
+  {
+    const std::vector<std::u16string_view> sources = detail::getCellStrings(cells, "matlabw:mx:toStrings");
+
+    const std::size_t count = sources.size();
+
+    const std::size_t totalSize = std::accumulate(sources.begin(), sources.end(), std::size_t{},
+                                                  [](std::size_t sum, std::u16string_view str)
+    {
+      return sum + str.size();
+    });
+
+    const std::size_t threshold = detail::getStringThreshold(count, totalSize);
+
+    std::vector<std::size_t> offsets(count + 1);
+
+    detail::parallelFor<std::size_t>(count, [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        offsets[i + 1] = detail::utf16ToUtf8<false>(sources[i], nullptr);
+      }
+    }, threshold);
+
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    char* buffer = (offsets[count] != 0) ? static_cast<char*>(arena.allocate(offsets[count], 1)) : nullptr;
+
+    std::vector<std::string_view> strings(count);
+
+    detail::parallelFor<std::string_view>(count, [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        char* str = buffer + offsets[i];
+
+        strings[i] = std::string_view{str, detail::utf16ToUtf8<true>(sources[i], str)};
+      }
+    }, threshold);
+
+    return strings;
+  }
+
+  /**
+   * @brief Creates an Nx1 cell array of character row vectors from UTF-8 strings. The character arrays are created on
+   *        the calling thread and filled in parallel.
+   * @param strings The strings, empty strings become 0x0 character arrays.
+   * @return The cell array.
+   */
+  [[nodiscard]] inline CellArray makeCellStr(std::span<const std::string_view> strings)
+  {
+    return detail::makeCellStr(strings);
+  }
+
+  /**
+   * @brief Creates an Nx1 cell array of character row vectors from UTF-8 strings, see makeCellStr(std::span<const
+   *        std::string_view>).
+   * @param strings The strings.
+   * @return The cell array.
+   */
+  [[nodiscard]] inline CellArray makeCellStr(std::span<const std::string> strings)
+  {
+    return detail::makeCellStr(strings);
+  }
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_CELLSTR_HPP */
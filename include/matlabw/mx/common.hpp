@@ -83,6 +83,37 @@ namespace matlabw::mx
     complex = mxCOMPLEX, ///< Complex.
   };
 
+  namespace detail
+  {
+    /**
+     * @brief Gets the MATLAB name of a class.
+     * @param classId The class ID.
+     * @return The class name.
+     */
+    [[nodiscard]] constexpr std::string_view getClassName(ClassId classId) noexcept
+    {
+      switch (classId)
+      {
+        case ClassId::cell:     return "cell";
+        case ClassId::_struct:  return "struct";
+        case ClassId::logical:  return "logical";
+        case ClassId::_char:    return "char";
+        case ClassId::_double:  return "double";
+        case ClassId::single:   return "single";
+        case ClassId::int8:     return "int8";
+        case ClassId::uint8:    return "uint8";
+        case ClassId::int16:    return "int16";
+        case ClassId::uint16:   return "uint16";
+        case ClassId::int32:    return "int32";
+        case ClassId::uint32:   return "uint32";
+        case ClassId::int64:    return "int64";
+        case ClassId::uint64:   return "uint64";
+        case ClassId::function: return "function_handle";
+        default:                return "unknown";
+      }
+    }
+  } // namespace detail
+
   // Forward declarations.
   class Cell;
   class Object;
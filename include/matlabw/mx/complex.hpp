@@ -0,0 +1,379 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_COMPLEX_HPP
+#define MATLABW_MX_COMPLEX_HPP
+
+#include "detail/include.hpp"
+#include "detail/parallel.hpp"
+
+#include "Exception.hpp"
+#include "NumericArrayRef.hpp"
+#include "TypedArray.hpp"
+#include "typeTraits.hpp"
+
+namespace matlabw::mx
+{
+  namespace detail
+  {
+    /**
+     * @brief Scalar kernel splitting interleaved complex data into real and imaginary planes.
+     * @tparam T The component type.
+     * @param src Interleaved source data.
+     * @param re Real plane.
+     * @param im Imaginary plane.
+     * @param n Number of complex elements.
+     */
+    template<typename T>
+    void deinterleaveScalar(const T* src, T* re, T* im, std::size_t n) noexcept
+    {
+      for (std::size_t i{}; i < n; ++i)
+      {
+        re[i] = src[2 * i];
+        im[i] = src[2 * i + 1];
+      }
+    }
+
+    /**
+     * @brief Scalar kernel merging real and imaginary planes into interleaved complex data.
+     * @tparam T The component type.
+     * @param re Real plane.
+     * @param im Imaginary plane.
+     * @param dst Interleaved destination data.
+     * @param n Number of complex elements.
+     */
+    template<typename T>
+    void interleaveScalar(const T* re, const T* im, T* dst, std::size_t n) noexcept
+    {
+      for (std::size_t i{}; i < n; ++i)
+      {
+        dst[2 * i]     = re[i];
+        dst[2 * i + 1] = im[i];
+      }
+    }
+
+    /**
+     * @brief Vectorized kernel splitting interleaved complex data into real and imaginary planes.
+     * @tparam T The component type.
+     * @param src Interleaved source data.
+     * @param re Real plane.
+     * @param im Imaginary plane.
+     * @param n Number of complex elements.
+     */
+    template<typename T>
+    void deinterleaveKernel(const T* src, T* re, T* im, std::size_t n) noexcept
+    {
+      std::size_t i{};
+
+#   if defined(MATLABW_HAS_AVX512)
+      if constexpr (std::is_same_v<T, double>)
+      {
+        const __m512i reIdx = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+        const __m512i imIdx = _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15);
+
+        for (; i + 8 <= n; i += 8)
+        {
+          const __m512d a = _mm512_loadu_pd(src + 2 * i);
+          const __m512d b = _mm512_loadu_pd(src + 2 * i + 8);
+
+          _mm512_storeu_pd(re + i, _mm512_permutex2var_pd(a, reIdx, b));
+          _mm512_storeu_pd(im + i, _mm512_permutex2var_pd(a, imIdx, b));
+        }
+      }
+      else if constexpr (std::is_same_v<T, float>)
+      {
+        const __m512i reIdx = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+        const __m512i imIdx = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+
+        for (; i + 16 <= n; i += 16)
+        {
+          const __m512 a = _mm512_loadu_ps(src + 2 * i);
+          const __m512 b = _mm512_loadu_ps(src + 2 * i + 16);
+
+          _mm512_storeu_ps(re + i, _mm512_permutex2var_ps(a, reIdx, b));
+          _mm512_storeu_ps(im + i, _mm512_permutex2var_ps(a, imIdx, b));
+        }
+      }
+#   elif defined(MATLABW_HAS_AVX2)
+      if constexpr (std::is_same_v<T, double>)
+      {
+        for (; i + 4 <= n; i += 4)
+        {
+          const __m256d a = _mm256_loadu_pd(src + 2 * i);
+          const __m256d b = _mm256_loadu_pd(src + 2 * i + 4);
+
+          _mm256_storeu_pd(re + i, _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0)));
+          _mm256_storeu_pd(im + i, _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+      }
+      else if constexpr (std::is_same_v<T, float>)
+      {
+        for (; i + 8 <= n; i += 8)
+        {
+          const __m256 a = _mm256_loadu_ps(src + 2 * i);
+          const __m256 b = _mm256_loadu_ps(src + 2 * i + 8);
+
+          const __m256d r = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+          const __m256d m = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+          _mm256_storeu_ps(re + i, _mm256_castpd_ps(_mm256_permute4x64_pd(r, _MM_SHUFFLE(3, 1, 2, 0))));
+          _mm256_storeu_ps(im + i, _mm256_castpd_ps(_mm256_permute4x64_pd(m, _MM_SHUFFLE(3, 1, 2, 0))));
+        }
+      }
+#   elif defined(MATLABW_HAS_SSE2)
+      if constexpr (std::is_same_v<T, double>)
+      {
+        for (; i + 2 <= n; i += 2)
+        {
+          const __m128d a = _mm_loadu_pd(src + 2 * i);
+          const __m128d b = _mm_loadu_pd(src + 2 * i + 2);
+
+          _mm_storeu_pd(re + i, _mm_unpacklo_pd(a, b));
+          _mm_storeu_pd(im + i, _mm_unpackhi_pd(a, b));
+        }
+      }
+      else if constexpr (std::is_same_v<T, float>)
+      {
+        for (; i + 4 <= n; i += 4)
+        {
+          const __m128 a = _mm_loadu_ps(src + 2 * i);
+          const __m128 b = _mm_loadu_ps(src + 2 * i + 4);
+
+          _mm_storeu_ps(re + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+          _mm_storeu_ps(im + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+      }
+#   endif
+
+      deinterleaveScalar(src + 2 * i, re + i, im + i, n - i);
+    }
+
+    /**
+     * @brief Vectorized kernel merging real and imaginary planes into interleaved complex data.
+     * @tparam T The component type.
+     * @param re Real plane.
+     * @param im Imaginary plane.
+     * @param dst Interleaved destination data.
+     * @param n Number of complex elements.
+     */
+    template<typename T>
+    void interleaveKernel(const T* re, const T* im, T* dst, std::size_t n) noexcept
+    {
+      std::size_t i{};
+
+#   if defined(MATLABW_HAS_AVX512)
+      if constexpr (std::is_same_v<T, double>)
+      {
+        const __m512i loIdx = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11);
+        const __m512i hiIdx = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+
+        for (; i + 8 <= n; i += 8)
+        {
+          const __m512d r = _mm512_loadu_pd(re + i);
+          const __m512d m = _mm512_loadu_pd(im + i);
+
+          _mm512_storeu_pd(dst + 2 * i,     _mm512_permutex2var_pd(r, loIdx, m));
+          _mm512_storeu_pd(dst + 2 * i + 8, _mm512_permutex2var_pd(r, hiIdx, m));
+        }
+      }
+      else if constexpr (std::is_same_v<T, float>)
+      {
+        const __m512i loIdx = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+        const __m512i hiIdx = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+
+        for (; i + 16 <= n; i += 16)
+        {
+          const __m512 r = _mm512_loadu_ps(re + i);
+          const __m512 m = _mm512_loadu_ps(im + i);
+
+          _mm512_storeu_ps(dst + 2 * i,      _mm512_permutex2var_ps(r, loIdx, m));
+          _mm512_storeu_ps(dst + 2 * i + 16, _mm512_permutex2var_ps(r, hiIdx, m));
+        }
+      }
+#   elif defined(MATLABW_HAS_AVX2)
+      if constexpr (std::is_same_v<T, double>)
+      {
+        for (; i + 4 <= n; i += 4)
+        {
+          const __m256d r = _mm256_permute4x64_pd(_mm256_loadu_pd(re + i), _MM_SHUFFLE(3, 1, 2, 0));
+          const __m256d m = _mm256_permute4x64_pd(_mm256_loadu_pd(im + i), _MM_SHUFFLE(3, 1, 2, 0));
+
+          _mm256_storeu_pd(dst + 2 * i,     _mm256_unpacklo_pd(r, m));
+          _mm256_storeu_pd(dst + 2 * i + 4, _mm256_unpackhi_pd(r, m));
+        }
+      }
+      else if constexpr (std::is_same_v<T, float>)
+      {
+        for (; i + 8 <= n; i += 8)
+        {
+          const __m256 r = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_loadu_ps(re + i)),
+                                                                  _MM_SHUFFLE(3, 1, 2, 0)));
+          const __m256 m = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_loadu_ps(im + i)),
+                                                                  _MM_SHUFFLE(3, 1, 2, 0)));
+
+          _mm256_storeu_ps(dst + 2 * i,     _mm256_unpacklo_ps(r, m));
+          _mm256_storeu_ps(dst + 2 * i + 8, _mm256_unpackhi_ps(r, m));
+        }
+      }
+#   elif defined(MATLABW_HAS_SSE2)
+      if constexpr (std::is_same_v<T, double>)
+      {
+        for (; i + 2 <= n; i += 2)
+        {
+          const __m128d r = _mm_loadu_pd(re + i);
+          const __m128d m = _mm_loadu_pd(im + i);
+
+          _mm_storeu_pd(dst + 2 * i,     _mm_unpacklo_pd(r, m));
+          _mm_storeu_pd(dst + 2 * i + 2, _mm_unpackhi_pd(r, m));
+        }
+      }
+      else if constexpr (std::is_same_v<T, float>)
+      {
+        for (; i + 4 <= n; i += 4)
+        {
+          const __m128 r = _mm_loadu_ps(re + i);
+          const __m128 m = _mm_loadu_ps(im + i);
+
+          _mm_storeu_ps(dst + 2 * i,     _mm_unpacklo_ps(r, m));
+          _mm_storeu_ps(dst + 2 * i + 4, _mm_unpackhi_ps(r, m));
+        }
+      }
+#   endif
+
+      interleaveScalar(re + i, im + i, dst + 2 * i, n - i);
+    }
+  } // namespace detail
+
+  /**
+   * @brief Splits interleaved complex data into separate real and imaginary planes. Large inputs are processed in
+   *        parallel. The instruction set is selected at compile time: the AVX-512 and AVX2 kernels are used only
+   *        when the compiler targets them (MATLABW_HAS_AVX512, MATLABW_HAS_AVX2, e.g. -mavx2 or /arch:AVX2),
+   *        otherwise the SSE2 or scalar kernels run.
+   * @tparam T The component type.
+   * @param src The interleaved complex data.
+   * @param re The real plane. Must have the same size as src.
+   * @param im The imaginary plane. Must have the same size as src.
+   */
+  template<typename T, std::enable_if_t<isRealNumeric<T>, int> = 0>
+  void deinterleave(View<std::complex<T>> src, Span<T> re, Span<T> im)
+  {
+    if (re.size() != src.size() || im.size() != src.size())
+    {
+      throw Exception{"matlabw:mx:deinterleave", "size mismatch"};
+    }
+
+    const T* srcData = reinterpret_cast<const T*>(src.data());
+
+    detail::parallelFor<std::complex<T>>(src.size(), [&](std::size_t begin, std::size_t end)
+    {
+      detail::deinterleaveKernel(srcData + 2 * begin, re.data() + begin, im.data() + begin, end - begin);
+    });
+  }
+
+  /**
+   * @brief Splits a complex array into separate real and imaginary planes, see deinterleave(View, Span, Span).
+   * @tparam T The component type.
+   * @param src The complex array.
+   * @param re The real plane. Must have the same size as src.
+   * @param im The imaginary plane. Must have the same size as src.
+   */
+  template<typename T, std::enable_if_t<isRealNumeric<T>, int> = 0>
+  void deinterleave(TypedArrayCref<std::complex<T>> src,
+                    std::type_identity_t<Span<T>>   re,
+                    std::type_identity_t<Span<T>>   im)
+  {
+    deinterleave<T>(View<std::complex<T>>{src.getData(), src.getSize()}, re, im);
+  }
+
+  /**
+   * @brief Splits a complex array into separate real and imaginary planes, see deinterleave(View, Span, Span).
+   * @tparam T The component type.
+   * @param src The complex array.
+   * @param re The real plane. Must have the same size as src.
+   * @param im The imaginary plane. Must have the same size as src.
+   */
+  template<typename T, std::enable_if_t<isRealNumeric<T>, int> = 0>
+  void deinterleave(const TypedArray<std::complex<T>>& src,
+                    std::type_identity_t<Span<T>>      re,
+                    std::type_identity_t<Span<T>>      im)
+  {
+    deinterleave<T>(View<std::complex<T>>{src.getData(), src.getSize()}, re, im);
+  }
+
+  /**
+   * @brief Merges separate real and imaginary planes into interleaved complex data. Large inputs are processed in
+   *        parallel. The kernels are selected at compile time as for deinterleave.
+   * @tparam T The component type.
+   * @param re The real plane.
+   * @param im The imaginary plane. Must have the same size as re.
+   * @param dst The interleaved complex data. Must have the same size as re.
+   */
+  template<typename T, std::enable_if_t<isRealNumeric<T>, int> = 0>
+  void interleave(View<T> re, View<T> im, Span<std::complex<T>> dst)
+  {
+    if (im.size() != re.size() || dst.size() != re.size())
+    {
+      throw Exception{"matlabw:mx:interleave", "size mismatch"};
+    }
+
+    T* dstData = reinterpret_cast<T*>(dst.data());
+
+    detail::parallelFor<std::complex<T>>(dst.size(), [&](std::size_t begin, std::size_t end)
+    {
+      detail::interleaveKernel(re.data() + begin, im.data() + begin, dstData + 2 * begin, end - begin);
+    });
+  }
+
+  /**
+   * @brief Merges separate real and imaginary planes into a complex array, see interleave(View, View, Span).
+   * @tparam T The component type.
+   * @param re The real plane.
+   * @param im The imaginary plane. Must have the same size as re.
+   * @param dst The complex array. Must have the same size as re.
+   */
+  template<typename T, std::enable_if_t<isRealNumeric<T>, int> = 0>
+  void interleave(std::type_identity_t<View<T>>  re,
+                  std::type_identity_t<View<T>>  im,
+                  TypedArrayRef<std::complex<T>> dst)
+  {
+    interleave<T>(re, im, Span<std::complex<T>>{dst.getData(), dst.getSize()});
+  }
+
+  /**
+   * @brief Merges separate real and imaginary planes into a complex array, see interleave(View, View, Span).
+   * @tparam T The component type.
+   * @param re The real plane.
+   * @param im The imaginary plane. Must have the same size as re.
+   * @param dst The complex array. Must have the same size as re.
+   */
+  template<typename T, std::enable_if_t<isRealNumeric<T>, int> = 0>
+  void interleave(std::type_identity_t<View<T>> re,
+                  std::type_identity_t<View<T>> im,
+                  TypedArray<std::complex<T>>&  dst)
+  {
+    interleave<T>(re, im, Span<std::complex<T>>{dst.getData(), dst.getSize()});
+  }
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_COMPLEX_HPP */
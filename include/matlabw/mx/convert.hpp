@@ -0,0 +1,423 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_CONVERT_HPP
+#define MATLABW_MX_CONVERT_HPP
+
+#include "detail/include.hpp"
+#include "detail/parallel.hpp"
+
+#include "Array.hpp"
+#include "ArrayRef.hpp"
+#include "Exception.hpp"
+#include "NumericArray.hpp"
+#include "NumericArrayRef.hpp"
+#include "typeTraits.hpp"
+#include "visit.hpp"
+
+namespace matlabw::mx
+{
+  namespace detail
+  {
+    /**
+     * @brief Maps logical and char elements to the integer type they are converted from.
+     * @tparam T The element type.
+     */
+    template<typename T>
+    using ConvertSource = std::conditional_t<std::is_same_v<T, bool>, std::uint8_t,
+                          std::conditional_t<std::is_same_v<T, char16_t>, std::uint16_t, T>>;
+
+    /**
+     * @brief Converts a single real value with MATLAB semantics. Conversions to integers round half away from zero
+     *        and saturate, NaN is converted to 0.
+     * @tparam To The destination type.
+     * @tparam From The source type.
+     * @param value The value.
+     * @return The converted value.
+     */
+    template<typename To, typename From>
+    [[nodiscard]] To convertValue(From value) noexcept
+    {
+      using Src = ConvertSource<From>;
+
+      const Src src = static_cast<Src>(value);
+
+      if constexpr (std::is_floating_point_v<To> || std::is_same_v<To, Src>)
+      {
+        return static_cast<To>(src);
+      }
+      else if constexpr (std::is_floating_point_v<Src>)
+      {
+        constexpr Src lo = static_cast<Src>(std::numeric_limits<To>::min());
+        constexpr Src hi = static_cast<Src>(std::numeric_limits<To>::max());
+
+        if (src != src)
+        {
+          return To{};
+        }
+
+        Src r = std::trunc(src);
+
+        if (std::abs(src - r) >= Src{0.5})
+        {
+          r += std::copysign(Src{1}, src);
+        }
+
+        if (r <= lo)
+        {
+          return std::numeric_limits<To>::min();
+        }
+
+        if (r >= hi)
+        {
+          return std::numeric_limits<To>::max();
+        }
+
+        return static_cast<To>(r);
+      }
+      else
+      {
+        if (std::in_range<To>(src))
+        {
+          return static_cast<To>(src);
+        }
+
+        return std::cmp_less(src, 0) ? std::numeric_limits<To>::min() : std::numeric_limits<To>::max();
+      }
+    }
+
+    /**
+     * @brief Converts a range of real values with MATLAB semantics. Common conversions from double are vectorized,
+     *        the remaining ones are written to be auto-vectorized.
+     * @tparam To The destination type.
+     * @tparam From The source type.
+     * @param src The source values.
+     * @param dst The destination values.
+     * @param n The number of values.
+     */
+    template<typename To, typename From>
+    void convertKernel(const From* src, To* dst, std::size_t n) noexcept
+    {
+      std::size_t i{};
+
+#   ifdef MATLABW_HAS_AVX2
+      if constexpr (std::is_same_v<From, double> && std::is_same_v<To, float>)
+      {
+        for (; i + 4 <= n; i += 4)
+        {
+          _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+        }
+      }
+      else if constexpr (std::is_same_v<From, float> && std::is_same_v<To, double>)
+      {
+        for (; i + 4 <= n; i += 4)
+        {
+          _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm_loadu_ps(src + i)));
+        }
+      }
+      else if constexpr (std::is_same_v<From, std::int32_t> && std::is_same_v<To, double>)
+      {
+        for (; i + 4 <= n; i += 4)
+        {
+          _mm256_storeu_pd(dst + i, _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+        }
+      }
+      else if constexpr (std::is_same_v<From, double> && std::is_integral_v<To> &&
+                         (sizeof(To) < sizeof(std::int32_t) || std::is_same_v<To, std::int32_t>))
+      {
+        const __m256d lo   = _mm256_set1_pd(static_cast<double>(std::numeric_limits<To>::min()));
+        const __m256d hi   = _mm256_set1_pd(static_cast<double>(std::numeric_limits<To>::max()));
+        const __m256d half = _mm256_set1_pd(0.5);
+        const __m256d one  = _mm256_set1_pd(1.0);
+        const __m256d sign = _mm256_set1_pd(-0.0);
+
+        for (; i + 4 <= n; i += 4)
+        {
+          const __m256d x = _mm256_loadu_pd(src + i);
+          const __m256d t = _mm256_round_pd(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+
+          // round half away from zero
+          const __m256d frac = _mm256_andnot_pd(sign, _mm256_sub_pd(x, t));
+          const __m256d step = _mm256_or_pd(one, _mm256_and_pd(x, sign));
+          __m256d r = _mm256_add_pd(t, _mm256_and_pd(_mm256_cmp_pd(frac, half, _CMP_GE_OQ), step));
+
+          // saturate, NaN yields lo from max and is masked to zero
+          r = _mm256_min_pd(_mm256_max_pd(r, lo), hi);
+          r = _mm256_and_pd(r, _mm256_cmp_pd(x, x, _CMP_ORD_Q));
+
+          if constexpr (std::is_same_v<To, std::int32_t>)
+          {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvttpd_epi32(r));
+          }
+          else
+          {
+            alignas(16) std::int32_t tmp[4];
+
+            _mm_store_si128(reinterpret_cast<__m128i*>(tmp), _mm256_cvttpd_epi32(r));
+
+            for (std::size_t j{}; j < 4; ++j)
+            {
+              dst[i + j] = static_cast<To>(tmp[j]);
+            }
+          }
+        }
+      }
+#   endif
+
+      for (; i < n; ++i)
+      {
+        dst[i] = convertValue<To>(src[i]);
+      }
+    }
+
+    /**
+     * @brief Gets the real component type of a complex type, or the type itself.
+     * @tparam T The type.
+     */
+    template<typename T>
+    struct ComponentType
+    {
+      using type = T; ///< The component type.
+    };
+
+    /**
+     * @brief Specialization of ComponentType for std::complex<T>.
+     * @tparam T The component type.
+     */
+    template<typename T>
+    struct ComponentType<std::complex<T>>
+    {
+      using type = T; ///< The component type.
+    };
+
+    /**
+     * @brief Converts elements of a typed array into a buffer.
+     * @tparam To The destination type.
+     * @tparam From The source type.
+     * @param src The source elements.
+     * @param dst The destination elements, must have the same size as src.
+     */
+    template<typename To, typename From>
+    void convertElements(View<From> src, Span<To> dst)
+    {
+      using ToComponent   = typename ComponentType<To>::type;
+      using FromComponent = typename ComponentType<From>::type;
+
+      constexpr bool isToComplex   = isComplexNumeric<To>;
+      constexpr bool isFromComplex = isComplexNumeric<From>;
+
+      if constexpr (isFromComplex && !isToComplex)
+      {
+        throw Exception{"matlabw:mx:convert", "cannot convert complex values to a real type"};
+      }
+      else if constexpr (std::is_same_v<To, From>)
+      {
+        std::copy(src.begin(), src.end(), dst.begin());
+      }
+      else if constexpr (isToComplex && !isFromComplex)
+      {
+        parallelFor<To>(src.size(), [&](std::size_t begin, std::size_t end)
+        {
+          for (std::size_t i = begin; i < end; ++i)
+          {
+            dst[i] = To{convertValue<ToComponent>(src[i]), ToComponent{}};
+          }
+        });
+      }
+      else
+      {
+        // complex to complex converts both components in a single pass over the interleaved data
+        constexpr std::size_t k = isToComplex ? 2 : 1;
+
+        const auto* srcData = reinterpret_cast<const FromComponent*>(src.data());
+        auto*       dstData = reinterpret_cast<ToComponent*>(dst.data());
+
+        parallelFor<ToComponent>(k * src.size(), [&](std::size_t begin, std::size_t end)
+        {
+          convertKernel(srcData + begin, dstData + begin, end - begin);
+        });
+      }
+    }
+  } // namespace detail
+
+  /**
+   * @brief Result of mx::convert. Either references the input array when it already has the requested class, or
+   *        owns the converted array.
+   * @tparam T The element type.
+   */
+  template<typename T>
+  class ConvertedArray
+  {
+    public:
+      /**
+       * @brief Constructor referencing the input array.
+       * @param source The input array with the requested class.
+       */
+      explicit ConvertedArray(NumericArrayCref<T> source) noexcept
+      : mSource{source.get()}
+      {}
+
+      /**
+       * @brief Constructor owning the converted array.
+       * @param array The converted array.
+       */
+      explicit ConvertedArray(NumericArray<T>&& array) noexcept
+      : mArray{std::move(array)}, mSource{mArray.get()}
+      {}
+
+      /// @brief Explicitly deleted copy constructor.
+      ConvertedArray(const ConvertedArray&) = delete;
+
+      /// @brief Move constructor.
+      ConvertedArray(ConvertedArray&& other) noexcept
+      : mArray{std::move(other.mArray)}, mSource{std::exchange(other.mSource, nullptr)}
+      {}
+
+      /// @brief Destructor.
+      ~ConvertedArray() noexcept = default;
+
+      /// @brief Explicitly deleted copy assignment operator.
+      ConvertedArray& operator=(const ConvertedArray&) = delete;
+
+      /// @brief Explicitly deleted move assignment operator.
+      ConvertedArray& operator=(ConvertedArray&&) = delete;
+
+      /**
+       * @brief Checks if the input had to be converted.
+       * @return True if the result owns a converted array, false if it references the input.
+       */
+      [[nodiscard]] bool isConverted() const
+      {
+        return mArray.isValid();
+      }
+
+      /**
+       * @brief Gets a const reference to the result.
+       * @return The const reference.
+       */
+      [[nodiscard]] NumericArrayCref<T> getCref() const
+      {
+        if (mSource == nullptr)
+        {
+          throw Exception{"matlabw:mx:ConvertedArray:getCref", "invalid converted array"};
+        }
+
+        return NumericArrayCref<T>{mSource};
+      }
+
+      /**
+       * @brief Conversion operator to NumericArrayCref.
+       * @return The const reference.
+       */
+      [[nodiscard]] operator NumericArrayCref<T>() const
+      {
+        return getCref();
+      }
+
+      /**
+       * @brief Converts the result to an owned array. The converted array is moved out, the referenced input is
+       *        duplicated.
+       * @return The owned array.
+       */
+      [[nodiscard]] NumericArray<T> toArray() &&
+      {
+        if (isConverted())
+        {
+          mSource = nullptr;
+          return std::move(mArray);
+        }
+
+        return NumericArray<T>{getCref()};
+      }
+    private:
+      NumericArray<T> mArray{};  ///< The converted array, invalid if the input is referenced.
+      const mxArray*  mSource{}; ///< The resulting array.
+  };
+
+  /**
+   * @brief Converts the elements of an array into an existing buffer with MATLAB semantics. Conversions to integers
+   *        round half away from zero and saturate, NaN is converted to 0. Large arrays are converted in parallel.
+   * @tparam To The destination element type.
+   * @param array The full numeric, logical or char array.
+   * @param dst The destination buffer, must have the same number of elements as the array.
+   */
+  template<typename To, std::enable_if_t<isNumeric<To>, int> = 0>
+  void convert(ArrayCref array, Span<To> dst)
+  {
+    // sparse data holds only the nonzeros, not getSize() elements
+    if (array.isSparse())
+    {
+      throw Exception{"matlabw:mx:convert", "input must not be sparse"};
+    }
+
+    if (dst.size() != array.getSize())
+    {
+      throw Exception{"matlabw:mx:convert", "size mismatch"};
+    }
+
+    visit(array, [&](auto src)
+    {
+      using From = std::remove_cv_t<typename decltype(src)::value_type>;
+
+      if constexpr (isNumeric<From> || std::is_same_v<From, bool> || std::is_same_v<From, char16_t>)
+      {
+        detail::convertElements<To, From>(View<From>{src.getData(), src.getSize()}, dst);
+      }
+      else
+      {
+        throw Exception{"matlabw:mx:convert", "input must be numeric, logical or char"};
+      }
+    });
+  }
+
+  /**
+   * @brief Converts an array to the class of To with MATLAB semantics. Conversions to integers round half away from
+   *        zero and saturate, NaN is converted to 0. Large arrays are converted in parallel. If the array already has
+   *        the requested class and complexity, it is referenced without copying.
+   * @tparam To The destination element type.
+   * @param array The full numeric, logical or char array.
+   * @return The converted array.
+   */
+  template<typename To, std::enable_if_t<isNumeric<To>, int> = 0>
+  [[nodiscard]] ConvertedArray<To> convert(ArrayCref array)
+  {
+    if (array.isSparse())
+    {
+      throw Exception{"matlabw:mx:convert", "input must not be sparse"};
+    }
+
+    if (array.getClassId() == TypeProperties<To>::classId && array.isComplex() == isComplexNumeric<To>)
+    {
+      return ConvertedArray<To>{NumericArrayCref<To>{array}};
+    }
+
+    NumericArray<To> result = makeUninitNumericArray<To>(array.getDims());
+
+    convert<To>(array, Span<To>{result.getData(), result.getSize()});
+
+    return ConvertedArray<To>{std::move(result)};
+  }
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_CONVERT_HPP */
@@ -27,21 +27,61 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
 #include <complex>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <exception>
+#include <filesystem>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <numeric>
 #include <optional>
+#include <ranges>
 #include <span>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#if __has_include(<mdspan>)
+# include <mdspan>
+#endif
+
+// std::mdspan is available since C++23, mx/detail/mdspan.hpp provides a replacement otherwise
+#if defined(__cpp_lib_mdspan) && !defined(MATLABW_HAS_MDSPAN)
+# define MATLABW_HAS_MDSPAN
+#endif
+
+// x86 SIMD instruction sets enabled by the compiler flags
+#if (defined(__SSE2__) || defined(_M_X64)) && !defined(MATLABW_HAS_SSE2)
+# define MATLABW_HAS_SSE2
+#endif
+
+#if defined(__AVX2__) && !defined(MATLABW_HAS_AVX2)
+# define MATLABW_HAS_AVX2
+#endif
+
+#if defined(__AVX512F__) && !defined(MATLABW_HAS_AVX512)
+# define MATLABW_HAS_AVX512
+#endif
+
+#ifdef MATLABW_HAS_SSE2
+# include <immintrin.h>
+#endif
+
 #include <matrix.h>
 #ifdef MATLABW_ENABLE_GPU
 # include <gpu/mxGPUArray.h>
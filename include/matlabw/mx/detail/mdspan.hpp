@@ -0,0 +1,581 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_DETAIL_MDSPAN_HPP
+#define MATLABW_MX_DETAIL_MDSPAN_HPP
+
+#include "include.hpp"
+
+// Minimal C++20 replacement of std::extents, std::layout_left, std::layout_stride and std::mdspan used when the
+// standard library does not provide <mdspan>. Only the subset used by the library is implemented, the member names
+// follow the standard so that code written against it compiles with both.
+namespace matlabw::mx::detail
+{
+  /**
+   * @brief Replacement of std::extents with std::size_t indices.
+   * @tparam exts The extents, std::dynamic_extent for dynamic dimensions.
+   */
+  template<std::size_t... exts>
+  class MdExtents
+  {
+    public:
+      using index_type = std::size_t; ///< Index type
+      using size_type  = std::size_t; ///< Size type
+      using rank_type  = std::size_t; ///< Rank type
+
+      /**
+       * @brief Gets the rank.
+       * @return The number of dimensions.
+       */
+      [[nodiscard]] static constexpr rank_type rank() noexcept
+      {
+        return sizeof...(exts);
+      }
+
+      /**
+       * @brief Gets the number of dynamic dimensions.
+       * @return The number of dynamic dimensions.
+       */
+      [[nodiscard]] static constexpr rank_type rank_dynamic() noexcept
+      {
+        return ((exts == std::dynamic_extent) + ... + rank_type{});
+      }
+
+      /**
+       * @brief Gets the static extent of a dimension.
+       * @param r The dimension.
+       * @return The static extent or std::dynamic_extent.
+       */
+      [[nodiscard]] static constexpr std::size_t static_extent(rank_type r) noexcept
+      {
+        constexpr std::size_t staticExtents[]{exts..., 0};
+
+        return staticExtents[r];
+      }
+
+      /// @brief Default constructor, dynamic extents are zero.
+      constexpr MdExtents() noexcept
+      : mExtents{((exts == std::dynamic_extent) ? 0 : exts)...}
+      {}
+
+      /**
+       * @brief Constructor from the extents of all dimensions or of the dynamic dimensions only.
+       * @tparam Indices The index types.
+       * @param indices The extents.
+       */
+      template<typename... Indices>
+        requires ((sizeof...(Indices) == rank() || sizeof...(Indices) == rank_dynamic())
+                  && sizeof...(Indices) > 0
+                  && (std::is_convertible_v<Indices, std::size_t> && ...))
+      constexpr explicit MdExtents(Indices... indices) noexcept
+      : MdExtents{std::array<std::size_t, sizeof...(Indices)>{static_cast<std::size_t>(indices)...}}
+      {}
+
+      /**
+       * @brief Constructor from the extents of all dimensions or of the dynamic dimensions only.
+       * @tparam n The number of extents.
+       * @param indices The extents.
+       */
+      template<std::size_t n>
+        requires (n == rank() || n == rank_dynamic())
+      constexpr explicit(n != rank_dynamic()) MdExtents(const std::array<std::size_t, n>& indices) noexcept
+      {
+        std::size_t k{};
+
+        for (rank_type r{}; r < rank(); ++r)
+        {
+          if constexpr (n == rank())
+          {
+            mExtents[r] = indices[r];
+          }
+          else
+          {
+            mExtents[r] = (static_extent(r) == std::dynamic_extent) ? indices[k++] : static_extent(r);
+          }
+        }
+      }
+
+      /**
+       * @brief Gets the extent of a dimension.
+       * @param r The dimension.
+       * @return The extent.
+       */
+      [[nodiscard]] constexpr index_type extent(rank_type r) const noexcept
+      {
+        return mExtents[r];
+      }
+
+      /**
+       * @brief Compares the extents.
+       * @tparam others The other extents.
+       * @param other The other extents.
+       * @return True if the rank and all extents are equal.
+       */
+      template<std::size_t... others>
+      [[nodiscard]] friend constexpr bool operator==(const MdExtents& extents, const MdExtents<others...>& other) noexcept
+      {
+        if constexpr (sizeof...(others) != rank())
+        {
+          return false;
+        }
+        else
+        {
+          for (rank_type r{}; r < rank(); ++r)
+          {
+            if (extents.extent(r) != other.extent(r))
+            {
+              return false;
+            }
+          }
+
+          return true;
+        }
+      }
+    private:
+      std::array<std::size_t, rank()> mExtents{}; ///< The extents of all dimensions.
+  };
+
+  /**
+   * @brief Helper building MdExtents with all dimensions dynamic.
+   * @tparam rank The rank.
+   */
+  template<std::size_t rank, typename = std::make_index_sequence<rank>>
+  struct MdDextentsHelper;
+
+  /**
+   * @brief Specialization of MdDextentsHelper expanding the index sequence.
+   * @tparam rank The rank.
+   * @tparam is The dimension indices.
+   */
+  template<std::size_t rank, std::size_t... is>
+  struct MdDextentsHelper<rank, std::index_sequence<is...>>
+  {
+    using Type = MdExtents<((void)is, std::dynamic_extent)...>; ///< The extents type.
+  };
+
+  /**
+   * @brief Replacement of std::dextents with std::size_t indices.
+   * @tparam rank The rank.
+   */
+  template<std::size_t rank>
+  using MdDextents = typename MdDextentsHelper<rank>::Type;
+
+  /// @brief Replacement of std::layout_left, the column-major layout of MATLAB arrays.
+  struct MdLayoutLeft
+  {
+    /**
+     * @brief Layout mapping.
+     * @tparam E The extents type.
+     */
+    template<typename E>
+    class mapping
+    {
+      public:
+        using extents_type = E;            ///< Extents type
+        using index_type   = std::size_t;  ///< Index type
+        using layout_type  = MdLayoutLeft; ///< Layout type
+
+        /// @brief Default constructor.
+        constexpr mapping() noexcept = default;
+
+        /**
+         * @brief Constructor.
+         * @param extents The extents.
+         */
+        constexpr mapping(const E& extents) noexcept
+        : mExtents{extents}
+        {}
+
+        /**
+         * @brief Gets the extents.
+         * @return The extents.
+         */
+        [[nodiscard]] constexpr const E& extents() const noexcept
+        {
+          return mExtents;
+        }
+
+        /**
+         * @brief Gets the stride of a dimension.
+         * @param r The dimension.
+         * @return The stride.
+         */
+        [[nodiscard]] constexpr index_type stride(std::size_t r) const noexcept
+        {
+          index_type stride{1};
+
+          for (std::size_t k{}; k < r; ++k)
+          {
+            stride *= mExtents.extent(k);
+          }
+
+          return stride;
+        }
+
+        /**
+         * @brief Gets the number of elements spanned by the mapping.
+         * @return The number of elements.
+         */
+        [[nodiscard]] constexpr index_type required_span_size() const noexcept
+        {
+          return stride(E::rank());
+        }
+
+        /**
+         * @brief Maps a multidimensional index to the offset.
+         * @param indices The indices.
+         * @return The offset.
+         */
+        [[nodiscard]] constexpr index_type operator()(const std::array<index_type, E::rank()>& indices) const noexcept
+        {
+          index_type offset{};
+          index_type stride{1};
+
+          for (std::size_t r{}; r < E::rank(); ++r)
+          {
+            offset += indices[r] * stride;
+            stride *= mExtents.extent(r);
+          }
+
+          return offset;
+        }
+
+        /**
+         * @brief Checks if the mapping is contiguous.
+         * @return Always true.
+         */
+        [[nodiscard]] static constexpr bool is_exhaustive() noexcept
+        {
+          return true;
+        }
+      private:
+        E mExtents{}; ///< The extents.
+    };
+  };
+
+  /// @brief Replacement of std::layout_stride.
+  struct MdLayoutStride
+  {
+    /**
+     * @brief Layout mapping.
+     * @tparam E The extents type.
+     */
+    template<typename E>
+    class mapping
+    {
+      public:
+        using extents_type = E;              ///< Extents type
+        using index_type   = std::size_t;    ///< Index type
+        using layout_type  = MdLayoutStride; ///< Layout type
+
+        /// @brief Default constructor, the mapping is column-major.
+        constexpr mapping() noexcept
+        : mapping{E{}, MdLayoutLeft::mapping<E>{}}
+        {}
+
+        /**
+         * @brief Constructor.
+         * @param extents The extents.
+         * @param strides The strides of the dimensions.
+         */
+        constexpr mapping(const E& extents, const std::array<index_type, E::rank()>& strides) noexcept
+        : mExtents{extents}, mStrides{strides}
+        {}
+
+        /**
+         * @brief Constructor from another mapping.
+         * @tparam M The other mapping type.
+         * @param extents The extents.
+         * @param other The other mapping.
+         */
+        template<typename M>
+        constexpr mapping(const E& extents, const M& other) noexcept
+        : mExtents{extents}
+        {
+          for (std::size_t r{}; r < E::rank(); ++r)
+          {
+            mStrides[r] = other.stride(r);
+          }
+        }
+
+        /**
+         * @brief Gets the extents.
+         * @return The extents.
+         */
+        [[nodiscard]] constexpr const E& extents() const noexcept
+        {
+          return mExtents;
+        }
+
+        /**
+         * @brief Gets the strides.
+         * @return The strides.
+         */
+        [[nodiscard]] constexpr const std::array<index_type, E::rank()>& strides() const noexcept
+        {
+          return mStrides;
+        }
+
+        /**
+         * @brief Gets the stride of a dimension.
+         * @param r The dimension.
+         * @return The stride.
+         */
+        [[nodiscard]] constexpr index_type stride(std::size_t r) const noexcept
+        {
+          return mStrides[r];
+        }
+
+        /**
+         * @brief Gets the number of elements spanned by the mapping.
+         * @return The number of elements.
+         */
+        [[nodiscard]] constexpr index_type required_span_size() const noexcept
+        {
+          index_type size{1};
+
+          for (std::size_t r{}; r < E::rank(); ++r)
+          {
+            if (mExtents.extent(r) == 0)
+            {
+              return 0;
+            }
+
+            size += (mExtents.extent(r) - 1) * mStrides[r];
+          }
+
+          return size;
+        }
+
+        /**
+         * @brief Maps a multidimensional index to the offset.
+         * @param indices The indices.
+         * @return The offset.
+         */
+        [[nodiscard]] constexpr index_type operator()(const std::array<index_type, E::rank()>& indices) const noexcept
+        {
+          index_type offset{};
+
+          for (std::size_t r{}; r < E::rank(); ++r)
+          {
+            offset += indices[r] * mStrides[r];
+          }
+
+          return offset;
+        }
+      private:
+        E                                 mExtents{}; ///< The extents.
+        std::array<index_type, E::rank()> mStrides{}; ///< The strides.
+    };
+  };
+
+  /**
+   * @brief Replacement of std::mdspan. Elements are accessed with md[std::array{i, j}], which std::mdspan supports as
+   *        well, with md[i] for rank 1 and with md[i, j] if the compiler supports multidimensional subscripts.
+   * @tparam T The element type.
+   * @tparam E The extents type.
+   * @tparam L The layout type.
+   */
+  template<typename T, typename E, typename L = MdLayoutLeft>
+  class Mdspan
+  {
+    public:
+      using extents_type     = E;                               ///< Extents type
+      using layout_type      = L;                               ///< Layout type
+      using mapping_type     = typename L::template mapping<E>; ///< Mapping type
+      using element_type     = T;                               ///< Element type
+      using value_type       = std::remove_cv_t<T>;             ///< Value type
+      using index_type       = std::size_t;                     ///< Index type
+      using size_type        = std::size_t;                     ///< Size type
+      using rank_type        = std::size_t;                     ///< Rank type
+      using data_handle_type = T*;                              ///< Data handle type
+      using reference        = T&;                              ///< Reference type
+
+      /// @brief Default constructor.
+      constexpr Mdspan() noexcept = default;
+
+      /**
+       * @brief Constructor.
+       * @param data The data.
+       * @param extents The extents.
+       */
+      constexpr Mdspan(T* data, const E& extents) noexcept
+        requires std::is_constructible_v<mapping_type, const E&>
+      : mData{data}, mMapping{extents}
+      {}
+
+      /**
+       * @brief Constructor.
+       * @param data The data.
+       * @param mapping The layout mapping.
+       */
+      constexpr Mdspan(T* data, const mapping_type& mapping) noexcept
+      : mData{data}, mMapping{mapping}
+      {}
+
+      /**
+       * @brief Converting constructor, e.g. from non-const to const elements.
+       * @tparam U The other element type.
+       * @param other The other mdspan.
+       */
+      template<typename U>
+        requires (!std::is_same_v<U, T> && std::is_convertible_v<U(*)[], T(*)[]>)
+      constexpr Mdspan(const Mdspan<U, E, L>& other) noexcept
+      : mData{other.data_handle()}, mMapping{other.mapping()}
+      {}
+
+      /**
+       * @brief Accesses an element.
+       * @param indices The indices of all dimensions.
+       * @return The element.
+       */
+      [[nodiscard]] constexpr reference operator[](const std::array<index_type, E::rank()>& indices) const noexcept
+      {
+        return mData[mMapping(indices)];
+      }
+
+      /**
+       * @brief Accesses an element of a rank 1 mdspan.
+       * @param i The index.
+       * @return The element.
+       */
+      [[nodiscard]] constexpr reference operator[](index_type i) const noexcept
+        requires (E::rank() == 1)
+      {
+        return mData[mMapping(std::array<index_type, 1>{i})];
+      }
+
+#   ifdef __cpp_multidimensional_subscript
+      /**
+       * @brief Accesses an element.
+       * @tparam Indices The index types.
+       * @param indices The indices of all dimensions.
+       * @return The element.
+       */
+      template<typename... Indices>
+        requires (sizeof...(Indices) == E::rank() && sizeof...(Indices) > 1
+                  && (std::is_convertible_v<Indices, index_type> && ...))
+      [[nodiscard]] constexpr reference operator[](Indices... indices) const noexcept
+      {
+        return mData[mMapping(std::array<index_type, E::rank()>{static_cast<index_type>(indices)...})];
+      }
+#   endif
+
+      /**
+       * @brief Gets the rank.
+       * @return The rank.
+       */
+      [[nodiscard]] static constexpr rank_type rank() noexcept
+      {
+        return E::rank();
+      }
+
+      /**
+       * @brief Gets the static extent of a dimension.
+       * @param r The dimension.
+       * @return The static extent or std::dynamic_extent.
+       */
+      [[nodiscard]] static constexpr std::size_t static_extent(rank_type r) noexcept
+      {
+        return E::static_extent(r);
+      }
+
+      /**
+       * @brief Gets the extent of a dimension.
+       * @param r The dimension.
+       * @return The extent.
+       */
+      [[nodiscard]] constexpr index_type extent(rank_type r) const noexcept
+      {
+        return extents().extent(r);
+      }
+
+      /**
+       * @brief Gets the number of elements.
+       * @return The number of elements.
+       */
+      [[nodiscard]] constexpr size_type size() const noexcept
+      {
+        size_type size{1};
+
+        for (rank_type r{}; r < rank(); ++r)
+        {
+          size *= extent(r);
+        }
+
+        return size;
+      }
+
+      /**
+       * @brief Checks if the mdspan has no elements.
+       * @return True if the mdspan is empty.
+       */
+      [[nodiscard]] constexpr bool empty() const noexcept
+      {
+        return size() == 0;
+      }
+
+      /**
+       * @brief Gets the data.
+       * @return The data.
+       */
+      [[nodiscard]] constexpr data_handle_type data_handle() const noexcept
+      {
+        return mData;
+      }
+
+      /**
+       * @brief Gets the layout mapping.
+       * @return The layout mapping.
+       */
+      [[nodiscard]] constexpr const mapping_type& mapping() const noexcept
+      {
+        return mMapping;
+      }
+
+      /**
+       * @brief Gets the extents.
+       * @return The extents.
+       */
+      [[nodiscard]] constexpr const extents_type& extents() const noexcept
+      {
+        return mMapping.extents();
+      }
+
+      /**
+       * @brief Gets the stride of a dimension.
+       * @param r The dimension.
+       * @return The stride.
+       */
+      [[nodiscard]] constexpr index_type stride(rank_type r) const noexcept
+      {
+        return mMapping.stride(r);
+      }
+    private:
+      T*           mData{};    ///< The data.
+      mapping_type mMapping{}; ///< The layout mapping.
+  };
+} // namespace matlabw::mx::detail
+
+#endif /* MATLABW_MX_DETAIL_MDSPAN_HPP */
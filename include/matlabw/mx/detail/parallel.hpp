@@ -0,0 +1,75 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_DETAIL_PARALLEL_HPP
+#define MATLABW_MX_DETAIL_PARALLEL_HPP
+
+#include "include.hpp"
+
+#include "../ThreadPool.hpp"
+
+namespace matlabw::mx::detail
+{
+  /// @brief Number of elements below which the data-parallel kernels run on the calling thread.
+  inline constexpr std::size_t parallelThreshold{1 << 18};
+
+  /// @brief Size of a cache line in bytes used to align the chunk boundaries.
+  inline constexpr std::size_t cacheLineSize{64};
+
+  /**
+   * @brief Splits the range [0, n) into chunks and calls fn(begin, end) for each of them on the shared thread pool.
+   *        Chunk boundaries are multiples of the cache line size in elements of type T. The first exception thrown
+   *        by fn is rethrown after all chunks have finished. The callable must not call into the MATLAB API.
+   * @tparam T The element type used to align the chunks.
+   * @tparam Fn The callable type.
+   * @param n The number of elements.
+   * @param fn The callable.
+   * @param threshold The minimum number of elements per chunk.
+   */
+  template<typename T, typename Fn>
+  void parallelFor(std::size_t n, Fn&& fn, std::size_t threshold = parallelThreshold)
+  {
+    constexpr std::size_t align = std::max(std::size_t{1}, cacheLineSize / sizeof(T));
+
+    const std::size_t maxChunkCount = n / std::max(threshold, std::size_t{1});
+
+    if (maxChunkCount <= 1)
+    {
+      fn(std::size_t{}, n);
+      return;
+    }
+
+    ThreadPool& pool = getThreadPool();
+
+    const std::size_t chunkCount = std::min(pool.getThreadCount(), maxChunkCount);
+    const std::size_t chunk      = ((n + chunkCount - 1) / chunkCount + align - 1) / align * align;
+
+    pool.run((n + chunk - 1) / chunk, [&](std::size_t i)
+    {
+      fn(i * chunk, std::min(n, (i + 1) * chunk));
+    });
+  }
+} // namespace matlabw::mx::detail
+
+#endif /* MATLABW_MX_DETAIL_PARALLEL_HPP */
@@ -0,0 +1,1189 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_EXPRESSION_HPP
+#define MATLABW_MX_EXPRESSION_HPP
+
+#include "detail/include.hpp"
+#include "detail/parallel.hpp"
+
+#include "convert.hpp"
+#include "Exception.hpp"
+#include "NumericArray.hpp"
+#include "NumericArrayRef.hpp"
+#include "TypedArray.hpp"
+#include "TypedArrayRef.hpp"
+#include "typeTraits.hpp"
+
+namespace matlabw::mx::expr
+{
+  namespace detail
+  {
+    using mx::detail::ComponentType;
+
+    /**
+     * @brief Checks if the type can be an element of an expression, i.e. real numeric, logical or complex
+     *        floating-point.
+     * @tparam T The element type.
+     */
+    template<typename T>
+    inline constexpr bool isElement = isRealNumeric<T> || std::is_same_v<T, bool> ||
+                                      (isComplexNumeric<T> && std::is_floating_point_v<typename ComponentType<T>::type>);
+
+    /**
+     * @brief Checks if the type is a 64-bit integer, whose values are not all representable in double.
+     * @tparam T The element type.
+     */
+    template<typename T>
+    inline constexpr bool isInteger64 = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) == 8;
+
+    /**
+     * @brief Type in which an operation producing T is computed. Integers up to 32 bits and logicals are computed in
+     *        double, which is exact for every result that does not saturate. 64-bit integers are computed in native
+     *        saturating integer arithmetic.
+     * @tparam T The element type.
+     */
+    template<typename T>
+    using Compute = std::conditional_t<isInteger64<T>, T, std::conditional_t<std::is_integral_v<T>, double, T>>;
+
+    /**
+     * @brief Type in which a binary operation producing T from L and R is computed. A 64-bit integer combined with
+     *        a floating-point operand is computed in long double, which holds every 64-bit integer exactly.
+     * @tparam T The element type.
+     * @tparam L The left element type.
+     * @tparam R The right element type.
+     */
+    template<typename T, typename L, typename R>
+    using BinaryCompute = std::conditional_t<isInteger64<T> && (std::is_floating_point_v<L> ||
+                                                                std::is_floating_point_v<R>),
+                                             long double,
+                                             Compute<T>>;
+
+    /**
+     * @brief Gets the magnitude of an integer as an unsigned value, exact for the minimum of a signed type.
+     * @tparam T The integer type.
+     * @param a The value.
+     * @return The magnitude.
+     */
+    template<typename T>
+    [[nodiscard]] constexpr std::make_unsigned_t<T> magnitude(T a) noexcept
+    {
+      using U = std::make_unsigned_t<T>;
+
+      if constexpr (std::is_signed_v<T>)
+      {
+        return (a < 0) ? static_cast<U>(U{} - static_cast<U>(a)) : static_cast<U>(a);
+      }
+      else
+      {
+        return a;
+      }
+    }
+
+    /**
+     * @brief Adds two integers, saturating on overflow.
+     * @tparam T The integer type.
+     * @param a The left value.
+     * @param b The right value.
+     * @return The saturated sum.
+     */
+    template<typename T>
+    [[nodiscard]] constexpr T addSaturate(T a, T b) noexcept
+    {
+      constexpr T lo = std::numeric_limits<T>::min();
+      constexpr T hi = std::numeric_limits<T>::max();
+
+      if constexpr (std::is_signed_v<T>)
+      {
+        if (b > 0 && a > hi - b)
+        {
+          return hi;
+        }
+
+        if (b < 0 && a < lo - b)
+        {
+          return lo;
+        }
+      }
+      else if (a > hi - b)
+      {
+        return hi;
+      }
+
+      return static_cast<T>(a + b);
+    }
+
+    /**
+     * @brief Subtracts two integers, saturating on overflow.
+     * @tparam T The integer type.
+     * @param a The left value.
+     * @param b The right value.
+     * @return The saturated difference.
+     */
+    template<typename T>
+    [[nodiscard]] constexpr T subtractSaturate(T a, T b) noexcept
+    {
+      constexpr T lo = std::numeric_limits<T>::min();
+      constexpr T hi = std::numeric_limits<T>::max();
+
+      if constexpr (std::is_signed_v<T>)
+      {
+        if (b < 0 && a > hi + b)
+        {
+          return hi;
+        }
+
+        if (b > 0 && a < lo + b)
+        {
+          return lo;
+        }
+      }
+      else if (a < b)
+      {
+        return lo;
+      }
+
+      return static_cast<T>(a - b);
+    }
+
+    /**
+     * @brief Multiplies two integers, saturating on overflow.
+     * @tparam T The integer type.
+     * @param a The left value.
+     * @param b The right value.
+     * @return The saturated product.
+     */
+    template<typename T>
+    [[nodiscard]] constexpr T multiplySaturate(T a, T b) noexcept
+    {
+      using U = std::make_unsigned_t<T>;
+
+      bool isNegative{};
+
+      if constexpr (std::is_signed_v<T>)
+      {
+        isNegative = (a < 0) != (b < 0);
+      }
+
+      const U ua    = magnitude(a);
+      const U ub    = magnitude(b);
+      const U limit = static_cast<U>(std::numeric_limits<T>::max()) + (isNegative ? 1 : 0);
+
+      if (ua != 0 && ub > limit / ua)
+      {
+        return isNegative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+      }
+
+      const U product = static_cast<U>(ua * ub);
+
+      return static_cast<T>(isNegative ? static_cast<U>(U{} - product) : product);
+    }
+
+    /**
+     * @brief Divides two integers with MATLAB semantics. The quotient is rounded half away from zero and saturated,
+     *        division by zero yields the extreme of the dividend's sign or 0.
+     * @tparam T The integer type.
+     * @param a The dividend.
+     * @param b The divisor.
+     * @return The quotient.
+     */
+    template<typename T>
+    [[nodiscard]] constexpr T divideSaturate(T a, T b) noexcept
+    {
+      constexpr T lo = std::numeric_limits<T>::min();
+      constexpr T hi = std::numeric_limits<T>::max();
+
+      if (b == 0)
+      {
+        return (a > 0) ? hi : ((a == 0) ? T{} : lo);
+      }
+
+      if constexpr (std::is_signed_v<T>)
+      {
+        if (a == lo && b == -1)
+        {
+          return hi;
+        }
+      }
+
+      T quotient = static_cast<T>(a / b);
+
+      const auto remainder = magnitude(static_cast<T>(a % b));
+      const auto divisor   = magnitude(b);
+
+      if (remainder >= divisor - remainder)
+      {
+        if constexpr (std::is_signed_v<T>)
+        {
+          quotient = static_cast<T>(quotient + (((a < 0) == (b < 0)) ? 1 : -1));
+        }
+        else
+        {
+          ++quotient;
+        }
+      }
+
+      return quotient;
+    }
+
+    /**
+     * @brief Real element class of a binary operation following MATLAB rules. Integers win over floating-point
+     *        types, single wins over double, logicals behave like double. Mixing different integer classes is an
+     *        error.
+     * @tparam L The left real type.
+     * @tparam R The right real type.
+     */
+    template<typename L, typename R>
+    struct PromoteReal
+    {
+      static constexpr bool isLeftInteger  = std::is_integral_v<L> && !std::is_same_v<L, bool>; ///< Left is integer.
+      static constexpr bool isRightInteger = std::is_integral_v<R> && !std::is_same_v<R, bool>; ///< Right is integer.
+
+      static_assert(!isLeftInteger || !isRightInteger || std::is_same_v<L, R>,
+                    "integers can only be combined with the same integer class or scalar doubles");
+
+      /// @brief The promoted type.
+      using type = std::conditional_t<isLeftInteger, L,
+                   std::conditional_t<isRightInteger, R,
+                   std::conditional_t<std::is_same_v<L, float> || std::is_same_v<R, float>, float, double>>>;
+    };
+
+    /**
+     * @brief Element type of a binary operation following MATLAB rules, complex if any operand is complex.
+     * @tparam L The left element type.
+     * @tparam R The right element type.
+     */
+    template<typename L, typename R>
+    using Promote = std::conditional_t<isComplexNumeric<L> || isComplexNumeric<R>,
+                                       std::complex<typename PromoteReal<typename ComponentType<L>::type,
+                                                                         typename ComponentType<R>::type>::type>,
+                                       typename PromoteReal<L, R>::type>;
+
+    /**
+     * @brief Converts a computed value to an element type, integers are rounded and saturated.
+     * @tparam To The element type.
+     * @tparam From The computed type.
+     * @param value The computed value.
+     * @return The element value.
+     */
+    template<typename To, typename From>
+    [[nodiscard]] To narrow(const From& value) noexcept
+    {
+      if constexpr (std::is_same_v<To, From>)
+      {
+        return value;
+      }
+      else if constexpr (std::is_integral_v<To>)
+      {
+        static_assert(!isComplexNumeric<From>, "cannot convert complex values to a real type");
+
+        return mx::detail::convertValue<To>(value);
+      }
+      else
+      {
+        static_assert(isComplexNumeric<To> || !isComplexNumeric<From>, "cannot convert complex values to a real type");
+
+        return static_cast<To>(value);
+      }
+    }
+
+    /**
+     * @brief Checks if two dimension vectors are equal.
+     * @param a The first dimensions.
+     * @param b The second dimensions.
+     * @return True if equal.
+     */
+    [[nodiscard]] inline bool isSameDims(View<std::size_t> a, View<std::size_t> b) noexcept
+    {
+      return std::ranges::equal(a, b);
+    }
+
+    /// @brief Dimensions of a scalar.
+    inline constexpr std::size_t scalarDims[]{1, 1};
+  } // namespace detail
+
+  /**
+   * @brief Expression leaf referencing array data. The array must outlive the expression.
+   * @tparam T The element type.
+   */
+  template<typename T>
+  class ArrayTerminal
+  {
+    public:
+      using value_type = T; ///< The element type.
+
+      /**
+       * @brief Constructor.
+       * @param data The array data.
+       * @param dims The array dimensions.
+       * @param size The number of elements.
+       */
+      ArrayTerminal(const T* data, View<std::size_t> dims, std::size_t size) noexcept
+      : mData{data}, mDims{dims}, mSize{size}
+      {}
+
+      /**
+       * @brief Gets an element.
+       * @param i The linear index.
+       * @return The element.
+       */
+      [[nodiscard]] T operator[](std::size_t i) const noexcept
+      {
+        return mData[i * mStride];
+      }
+
+      /**
+       * @brief Gets the number of elements.
+       * @return The number of elements.
+       */
+      [[nodiscard]] std::size_t getSize() const noexcept
+      {
+        return mSize;
+      }
+
+      /**
+       * @brief Gets the dimensions.
+       * @return The dimensions.
+       */
+      [[nodiscard]] View<std::size_t> getDims() const noexcept
+      {
+        return mDims;
+      }
+
+      /// @brief Expands a scalar to any size.
+      void broadcast() noexcept
+      {
+        mStride = 0;
+      }
+    private:
+      const T*          mData{};    ///< The array data.
+      View<std::size_t> mDims{};    ///< The array dimensions.
+      std::size_t       mSize{};    ///< The number of elements.
+      std::size_t       mStride{1}; ///< The index stride, 0 for an expanded scalar.
+  };
+
+  /**
+   * @brief Expression leaf holding a scalar value.
+   * @tparam T The element type.
+   */
+  template<typename T>
+  class ScalarTerminal
+  {
+    public:
+      using value_type = T; ///< The element type.
+
+      /**
+       * @brief Constructor.
+       * @param value The value.
+       */
+      explicit ScalarTerminal(T value) noexcept
+      : mValue{value}
+      {}
+
+      /**
+       * @brief Gets the value for any index.
+       * @return The value.
+       */
+      [[nodiscard]] T operator[](std::size_t) const noexcept
+      {
+        return mValue;
+      }
+
+      /**
+       * @brief Gets the number of elements.
+       * @return 1
+       */
+      [[nodiscard]] std::size_t getSize() const noexcept
+      {
+        return 1;
+      }
+
+      /**
+       * @brief Gets the dimensions.
+       * @return The scalar dimensions.
+       */
+      [[nodiscard]] View<std::size_t> getDims() const noexcept
+      {
+        return View<std::size_t>{detail::scalarDims};
+      }
+
+      /// @brief Scalars expand to any size.
+      void broadcast() noexcept {}
+    private:
+      T mValue{}; ///< The value.
+  };
+
+  /**
+   * @brief Lazy elementwise unary operation.
+   * @tparam Op The operation.
+   * @tparam E The operand expression type.
+   */
+  template<typename Op, typename E>
+  class UnaryExpression
+  {
+    public:
+      using value_type = typename Op::template Result<typename E::value_type>; ///< The element type.
+
+      /**
+       * @brief Constructor.
+       * @param expr The operand.
+       */
+      explicit UnaryExpression(E expr) noexcept
+      : mExpr{std::move(expr)}
+      {}
+
+      /**
+       * @brief Computes an element.
+       * @param i The linear index.
+       * @return The element.
+       */
+      [[nodiscard]] value_type operator[](std::size_t i) const noexcept
+      {
+        using C = detail::Compute<typename E::value_type>;
+
+        return detail::narrow<value_type>(Op::apply(static_cast<C>(mExpr[i])));
+      }
+
+      /**
+       * @brief Gets the number of elements.
+       * @return The number of elements.
+       */
+      [[nodiscard]] std::size_t getSize() const noexcept
+      {
+        return mExpr.getSize();
+      }
+
+      /**
+       * @brief Gets the dimensions.
+       * @return The dimensions.
+       */
+      [[nodiscard]] View<std::size_t> getDims() const noexcept
+      {
+        return mExpr.getDims();
+      }
+
+      /// @brief Expands a scalar to any size.
+      void broadcast() noexcept
+      {
+        mExpr.broadcast();
+      }
+    private:
+      E mExpr; ///< The operand.
+  };
+
+  /**
+   * @brief Lazy elementwise binary operation. The operands must have the same dimensions or one of them must be a
+   *        scalar.
+   * @tparam Op The operation.
+   * @tparam L The left operand expression type.
+   * @tparam R The right operand expression type.
+   */
+  template<typename Op, typename L, typename R>
+  class BinaryExpression
+  {
+    public:
+      using value_type = detail::Promote<typename L::value_type, typename R::value_type>; ///< The element type.
+
+      static_assert(detail::isElement<value_type>, "complex integer results are not supported");
+
+      static_assert(!std::is_same_v<detail::BinaryCompute<value_type, typename L::value_type, typename R::value_type>,
+                                    long double> || std::numeric_limits<long double>::digits >= 64,
+                    "64-bit integers can be combined with floating-point operands only if long double is exact for "
+                    "64-bit integers");
+
+      /**
+       * @brief Constructor.
+       * @param left The left operand.
+       * @param right The right operand.
+       */
+      BinaryExpression(L left, R right)
+      : mLeft{std::move(left)}, mRight{std::move(right)}
+      {
+        if (mLeft.getSize() == 1 && mRight.getSize() != 1)
+        {
+          mLeft.broadcast();
+        }
+        else if (mRight.getSize() == 1 && mLeft.getSize() != 1)
+        {
+          mRight.broadcast();
+        }
+        else if (!detail::isSameDims(mLeft.getDims(), mRight.getDims()))
+        {
+          throw Exception{"matlabw:mx:expr:dimensionMismatch", "array dimensions must match or be scalar"};
+        }
+      }
+
+      /**
+       * @brief Computes an element.
+       * @param i The linear index.
+       * @return The element.
+       */
+      [[nodiscard]] value_type operator[](std::size_t i) const noexcept
+      {
+        using C = detail::BinaryCompute<value_type, typename L::value_type, typename R::value_type>;
+
+        return detail::narrow<value_type>(Op::apply(static_cast<C>(mLeft[i]), static_cast<C>(mRight[i])));
+      }
+
+      /**
+       * @brief Gets the number of elements.
+       * @return The number of elements.
+       */
+      [[nodiscard]] std::size_t getSize() const noexcept
+      {
+        // a scalar operand takes the size of the other one, which may be empty
+        return (mLeft.getSize() == 1) ? mRight.getSize() : mLeft.getSize();
+      }
+
+      /**
+       * @brief Gets the dimensions.
+       * @return The dimensions.
+       */
+      [[nodiscard]] View<std::size_t> getDims() const noexcept
+      {
+        return (mLeft.getSize() == 1) ? mRight.getDims() : mLeft.getDims();
+      }
+
+      /// @brief Expands a scalar to any size.
+      void broadcast() noexcept
+      {
+        mLeft.broadcast();
+        mRight.broadcast();
+      }
+    private:
+      L mLeft;  ///< The left operand.
+      R mRight; ///< The right operand.
+  };
+
+  /**
+   * @brief IsExpression trait.
+   * @tparam T Type.
+   */
+  template<typename T>
+  struct IsExpression : std::false_type {};
+
+  /**
+   * @brief Specialization of IsExpression for ArrayTerminal.
+   * @tparam T The element type.
+   */
+  template<typename T>
+  struct IsExpression<ArrayTerminal<T>> : std::true_type {};
+
+  /**
+   * @brief Specialization of IsExpression for ScalarTerminal.
+   * @tparam T The element type.
+   */
+  template<typename T>
+  struct IsExpression<ScalarTerminal<T>> : std::true_type {};
+
+  /**
+   * @brief Specialization of IsExpression for UnaryExpression.
+   * @tparam Op The operation.
+   * @tparam E The operand expression type.
+   */
+  template<typename Op, typename E>
+  struct IsExpression<UnaryExpression<Op, E>> : std::true_type {};
+
+  /**
+   * @brief Specialization of IsExpression for BinaryExpression.
+   * @tparam Op The operation.
+   * @tparam L The left operand expression type.
+   * @tparam R The right operand expression type.
+   */
+  template<typename Op, typename L, typename R>
+  struct IsExpression<BinaryExpression<Op, L, R>> : std::true_type {};
+
+  /**
+   * @brief Expression concept.
+   * @tparam T Type.
+   */
+  template<typename T>
+  concept Expression = IsExpression<std::remove_cvref_t<T>>::value;
+
+  /**
+   * @brief Scalar operand concept, arithmetic or complex values.
+   * @tparam T Type.
+   */
+  template<typename T>
+  concept Scalar = !Expression<T> && detail::isElement<std::remove_cvref_t<T>>;
+
+  /**
+   * @brief Operand pair concept, at least one expression and otherwise a scalar.
+   * @tparam L The left type.
+   * @tparam R The right type.
+   */
+  template<typename L, typename R>
+  concept Operands = (Expression<L> && (Expression<R> || Scalar<R>)) || (Scalar<L> && Expression<R>);
+
+  namespace detail
+  {
+    /**
+     * @brief Element type of a C++ scalar operand. Integer scalars behave like MATLAB numeric literals, i.e. double.
+     * @tparam T The scalar type.
+     */
+    template<typename T>
+    using ScalarElement = std::conditional_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, double, T>;
+
+    /**
+     * @brief Converts an operand to an expression node.
+     * @tparam T The operand type.
+     * @param operand The operand.
+     * @return The expression node.
+     */
+    template<typename T>
+    [[nodiscard]] auto toNode(const T& operand)
+    {
+      if constexpr (Expression<T>)
+      {
+        return operand;
+      }
+      else
+      {
+        return ScalarTerminal<ScalarElement<T>>{static_cast<ScalarElement<T>>(operand)};
+      }
+    }
+
+    /// @brief Elementwise addition.
+    struct Plus
+    {
+      /**
+       * @brief Applies the operation.
+       * @tparam C The compute type.
+       * @param a The left value.
+       * @param b The right value.
+       * @return The result.
+       */
+      template<typename C>
+      [[nodiscard]] static C apply(C a, C b) noexcept
+      {
+        if constexpr (std::is_integral_v<C>)
+        {
+          return addSaturate(a, b);
+        }
+        else
+        {
+          return a + b;
+        }
+      }
+    };
+
+    /// @brief Elementwise subtraction.
+    struct Minus
+    {
+      /**
+       * @brief Applies the operation.
+       * @tparam C The compute type.
+       * @param a The left value.
+       * @param b The right value.
+       * @return The result.
+       */
+      template<typename C>
+      [[nodiscard]] static C apply(C a, C b) noexcept
+      {
+        if constexpr (std::is_integral_v<C>)
+        {
+          return subtractSaturate(a, b);
+        }
+        else
+        {
+          return a - b;
+        }
+      }
+    };
+
+    /// @brief Elementwise multiplication, MATLAB's times.
+    struct Times
+    {
+      /**
+       * @brief Applies the operation.
+       * @tparam C The compute type.
+       * @param a The left value.
+       * @param b The right value.
+       * @return The result.
+       */
+      template<typename C>
+      [[nodiscard]] static C apply(C a, C b) noexcept
+      {
+        if constexpr (std::is_integral_v<C>)
+        {
+          return multiplySaturate(a, b);
+        }
+        else
+        {
+          return a * b;
+        }
+      }
+    };
+
+    /// @brief Elementwise right division, MATLAB's rdivide.
+    struct Divide
+    {
+      /**
+       * @brief Applies the operation.
+       * @tparam C The compute type.
+       * @param a The left value.
+       * @param b The right value.
+       * @return The result.
+       */
+      template<typename C>
+      [[nodiscard]] static C apply(C a, C b) noexcept
+      {
+        if constexpr (std::is_integral_v<C>)
+        {
+          return divideSaturate(a, b);
+        }
+        else
+        {
+          return a / b;
+        }
+      }
+    };
+
+    /// @brief Elementwise minimum, NaN values are omitted.
+    struct Min
+    {
+      /**
+       * @brief Applies the operation.
+       * @tparam C The compute type.
+       * @param a The left value.
+       * @param b The right value.
+       * @return The result.
+       */
+      template<typename C>
+      [[nodiscard]] static C apply(C a, C b) noexcept
+      {
+        static_assert(!isComplexNumeric<C>, "min is defined for real values only");
+
+        return (b < a || a != a) ? b : a;
+      }
+    };
+
+    /// @brief Elementwise maximum, NaN values are omitted.
+    struct Max
+    {
+      /**
+       * @brief Applies the operation.
+       * @tparam C The compute type.
+       * @param a The left value.
+       * @param b The right value.
+       * @return The result.
+       */
+      template<typename C>
+      [[nodiscard]] static C apply(C a, C b) noexcept
+      {
+        static_assert(!isComplexNumeric<C>, "max is defined for real values only");
+
+        return (b > a || a != a) ? b : a;
+      }
+    };
+
+    /// @brief Elementwise negation, logicals yield double.
+    struct Negate
+    {
+      /// @brief Result element type.
+      template<typename T>
+      using Result = std::conditional_t<std::is_same_v<T, bool>, double, T>;
+
+      /**
+       * @brief Applies the operation.
+       * @tparam C The compute type.
+       * @param a The value.
+       * @return The result.
+       */
+      template<typename C>
+      [[nodiscard]] static C apply(C a) noexcept
+      {
+        if constexpr (std::is_integral_v<C>)
+        {
+          return subtractSaturate(C{}, a);
+        }
+        else
+        {
+          return -a;
+        }
+      }
+    };
+
+    /// @brief Elementwise absolute value, complex values yield their magnitude.
+    struct Abs
+    {
+      /// @brief Result element type.
+      template<typename T>
+      using Result = typename ComponentType<std::conditional_t<std::is_same_v<T, bool>, double, T>>::type;
+
+      /**
+       * @brief Applies the operation.
+       * @tparam C The compute type.
+       * @param a The value.
+       * @return The result.
+       */
+      template<typename C>
+      [[nodiscard]] static auto apply(C a) noexcept
+      {
+        if constexpr (std::is_integral_v<C>)
+        {
+          return (a < C{}) ? subtractSaturate(C{}, a) : a;
+        }
+        else
+        {
+          return std::abs(a);
+        }
+      }
+    };
+
+    /**
+     * @brief Elementwise floating-point function.
+     * @tparam Fn The function.
+     */
+    template<auto Fn>
+    struct Math
+    {
+      /// @brief Result element type.
+      template<typename T>
+      using Result = T;
+
+      /**
+       * @brief Applies the operation.
+       * @tparam C The compute type.
+       * @param a The value.
+       * @return The result.
+       */
+      template<typename C>
+      [[nodiscard]] static C apply(C a) noexcept
+      {
+        static_assert(!std::is_integral_v<C>, "floating-point functions are not defined for 64-bit integers");
+
+        return Fn(a);
+      }
+    };
+
+    /// @brief Square root functor.
+    inline constexpr auto sqrtFn = [](const auto& a) { using std::sqrt; return sqrt(a); };
+
+    /// @brief Exponential functor.
+    inline constexpr auto expFn = [](const auto& a) { using std::exp; return exp(a); };
+
+    /// @brief Natural logarithm functor.
+    inline constexpr auto logFn = [](const auto& a) { using std::log; return log(a); };
+
+    /// @brief Sine functor.
+    inline constexpr auto sinFn = [](const auto& a) { using std::sin; return sin(a); };
+
+    /// @brief Cosine functor.
+    inline constexpr auto cosFn = [](const auto& a) { using std::cos; return cos(a); };
+
+    /**
+     * @brief Creates a binary expression.
+     * @tparam Op The operation.
+     * @tparam L The left operand type.
+     * @tparam R The right operand type.
+     * @param left The left operand.
+     * @param right The right operand.
+     * @return The expression.
+     */
+    template<typename Op, typename L, typename R>
+    [[nodiscard]] auto makeBinary(const L& left, const R& right)
+    {
+      auto l = toNode(left);
+      auto r = toNode(right);
+
+      return BinaryExpression<Op, decltype(l), decltype(r)>{std::move(l), std::move(r)};
+    }
+
+    /**
+     * @brief Creates a unary expression.
+     * @tparam Op The operation.
+     * @tparam E The operand type.
+     * @param expr The operand.
+     * @return The expression.
+     */
+    template<typename Op, typename E>
+    [[nodiscard]] auto makeUnary(const E& expr)
+    {
+      return UnaryExpression<Op, std::remove_cvref_t<E>>{expr};
+    }
+
+    /**
+     * @brief Checks if the expression has a floating-point element type.
+     * @tparam E The expression type.
+     */
+    template<typename E>
+    inline constexpr bool isFloatingExpression =
+      std::is_floating_point_v<typename ComponentType<typename std::remove_cvref_t<E>::value_type>::type>;
+  } // namespace detail
+
+  /**
+   * @brief Wraps an array reference into an expression leaf.
+   * @tparam T The element type.
+   * @param array The array, must outlive the expression.
+   * @return The expression leaf.
+   */
+  template<typename T, std::enable_if_t<detail::isElement<T>, int> = 0>
+  [[nodiscard]] ArrayTerminal<T> lazy(TypedArrayCref<T> array)
+  {
+    return ArrayTerminal<T>{array.getData(), array.getDims(), array.getSize()};
+  }
+
+  /**
+   * @brief Wraps an array reference into an expression leaf.
+   * @tparam T The element type.
+   * @param array The array, must outlive the expression.
+   * @return The expression leaf.
+   */
+  template<typename T, std::enable_if_t<detail::isElement<T>, int> = 0>
+  [[nodiscard]] ArrayTerminal<T> lazy(TypedArrayRef<T> array)
+  {
+    return ArrayTerminal<T>{array.getData(), array.getDims(), array.getSize()};
+  }
+
+  /**
+   * @brief Wraps an array into an expression leaf.
+   * @tparam T The element type.
+   * @param array The array, must outlive the expression.
+   * @return The expression leaf.
+   */
+  template<typename T, std::enable_if_t<detail::isElement<T>, int> = 0>
+  [[nodiscard]] ArrayTerminal<T> lazy(const TypedArray<T>& array)
+  {
+    return ArrayTerminal<T>{array.getData(), array.getDims(), array.getSize()};
+  }
+
+  /// @brief Explicitly deleted wrapping of a temporary array, it would dangle.
+  template<typename T>
+  void lazy(TypedArray<T>&&) = delete;
+
+  /**
+   * @brief Elementwise addition.
+   * @param left The left operand.
+   * @param right The right operand.
+   * @return The lazy expression.
+   */
+  template<typename L, typename R> requires Operands<L, R>
+  [[nodiscard]] auto operator+(const L& left, const R& right)
+  {
+    return detail::makeBinary<detail::Plus>(left, right);
+  }
+
+  /**
+   * @brief Elementwise subtraction.
+   * @param left The left operand.
+   * @param right The right operand.
+   * @return The lazy expression.
+   */
+  template<typename L, typename R> requires Operands<L, R>
+  [[nodiscard]] auto operator-(const L& left, const R& right)
+  {
+    return detail::makeBinary<detail::Minus>(left, right);
+  }
+
+  /**
+   * @brief Elementwise multiplication, MATLAB's .* operator.
+   * @param left The left operand.
+   * @param right The right operand.
+   * @return The lazy expression.
+   */
+  template<typename L, typename R> requires Operands<L, R>
+  [[nodiscard]] auto operator*(const L& left, const R& right)
+  {
+    return detail::makeBinary<detail::Times>(left, right);
+  }
+
+  /**
+   * @brief Elementwise right division, MATLAB's ./ operator.
+   * @param left The left operand.
+   * @param right The right operand.
+   * @return The lazy expression.
+   */
+  template<typename L, typename R> requires Operands<L, R>
+  [[nodiscard]] auto operator/(const L& left, const R& right)
+  {
+    return detail::makeBinary<detail::Divide>(left, right);
+  }
+
+  /**
+   * @brief Elementwise negation.
+   * @param expr The operand.
+   * @return The lazy expression.
+   */
+  template<Expression E>
+  [[nodiscard]] auto operator-(const E& expr)
+  {
+    return detail::makeUnary<detail::Negate>(expr);
+  }
+
+  /**
+   * @brief Elementwise minimum of real operands, NaN values are omitted.
+   * @param left The left operand.
+   * @param right The right operand.
+   * @return The lazy expression.
+   */
+  template<typename L, typename R> requires Operands<L, R>
+  [[nodiscard]] auto min(const L& left, const R& right)
+  {
+    return detail::makeBinary<detail::Min>(left, right);
+  }
+
+  /**
+   * @brief Elementwise maximum of real operands, NaN values are omitted.
+   * @param left The left operand.
+   * @param right The right operand.
+   * @return The lazy expression.
+   */
+  template<typename L, typename R> requires Operands<L, R>
+  [[nodiscard]] auto max(const L& left, const R& right)
+  {
+    return detail::makeBinary<detail::Max>(left, right);
+  }
+
+  /**
+   * @brief Elementwise absolute value.
+   * @param expr The operand.
+   * @return The lazy expression.
+   */
+  template<Expression E>
+  [[nodiscard]] auto abs(const E& expr)
+  {
+    return detail::makeUnary<detail::Abs>(expr);
+  }
+
+  /**
+   * @brief Elementwise square root of a floating-point expression. Negative real values yield NaN.
+   * @param expr The operand.
+   * @return The lazy expression.
+   */
+  template<Expression E> requires detail::isFloatingExpression<E>
+  [[nodiscard]] auto sqrt(const E& expr)
+  {
+    return detail::makeUnary<detail::Math<detail::sqrtFn>>(expr);
+  }
+
+  /**
+   * @brief Elementwise exponential of a floating-point expression.
+   * @param expr The operand.
+   * @return The lazy expression.
+   */
+  template<Expression E> requires detail::isFloatingExpression<E>
+  [[nodiscard]] auto exp(const E& expr)
+  {
+    return detail::makeUnary<detail::Math<detail::expFn>>(expr);
+  }
+
+  /**
+   * @brief Elementwise natural logarithm of a floating-point expression. Negative real values yield NaN.
+   * @param expr The operand.
+   * @return The lazy expression.
+   */
+  template<Expression E> requires detail::isFloatingExpression<E>
+  [[nodiscard]] auto log(const E& expr)
+  {
+    return detail::makeUnary<detail::Math<detail::logFn>>(expr);
+  }
+
+  /**
+   * @brief Elementwise sine of a floating-point expression.
+   * @param expr The operand.
+   * @return The lazy expression.
+   */
+  template<Expression E> requires detail::isFloatingExpression<E>
+  [[nodiscard]] auto sin(const E& expr)
+  {
+    return detail::makeUnary<detail::Math<detail::sinFn>>(expr);
+  }
+
+  /**
+   * @brief Elementwise cosine of a floating-point expression.
+   * @param expr The operand.
+   * @return The lazy expression.
+   */
+  template<Expression E> requires detail::isFloatingExpression<E>
+  [[nodiscard]] auto cos(const E& expr)
+  {
+    return detail::makeUnary<detail::Math<detail::cosFn>>(expr);
+  }
+
+  /**
+   * @brief Evaluates an expression into an existing buffer in a single pass, in parallel above the threshold. The
+   *        buffer may alias the operands. Values are converted with MATLAB semantics.
+   * @tparam T The destination element type.
+   * @tparam E The expression type.
+   * @param dst The destination, must have as many elements as the expression.
+   * @param expr The expression.
+   * @param threshold The minimum number of elements processed by a single task.
+   */
+  template<typename T, Expression E>
+  void assign(Span<T> dst, const E& expr, std::size_t threshold = mx::detail::parallelThreshold)
+  {
+    if (dst.size() != expr.getSize())
+    {
+      throw Exception{"matlabw:mx:expr:assign", "size mismatch"};
+    }
+
+    T* data = dst.data();
+
+    mx::detail::parallelFor<T>(dst.size(), [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        data[i] = detail::narrow<T>(expr[i]);
+      }
+    }, threshold);
+  }
+
+  /**
+   * @brief Evaluates an expression into an existing array in a single pass, in parallel above the threshold. The
+   *        array may alias the operands. Values are converted with MATLAB semantics.
+   * @tparam T The destination element type.
+   * @tparam E The expression type.
+   * @param dst The destination array, must have as many elements as the expression.
+   * @param expr The expression.
+   * @param threshold The minimum number of elements processed by a single task.
+   */
+  template<typename T, Expression E>
+  void assign(TypedArrayRef<T> dst, const E& expr, std::size_t threshold = mx::detail::parallelThreshold)
+  {
+    assign(Span<T>{dst.getData(), dst.getSize()}, expr, threshold);
+  }
+
+  /**
+   * @brief Evaluates an expression into a new array in a single pass, in parallel above the threshold.
+   * @tparam E The expression type.
+   * @param expr The expression.
+   * @param threshold The minimum number of elements processed by a single task.
+   * @return The array with the expression's dimensions and element type.
+   */
+  template<Expression E> requires isNumeric<typename E::value_type>
+  [[nodiscard]] NumericArray<typename E::value_type> evaluate(const E& expr,
+                                                              std::size_t threshold = mx::detail::parallelThreshold)
+  {
+    using T = typename E::value_type;
+
+    NumericArray<T> result = makeUninitNumericArray<T>(expr.getDims());
+
+    assign(Span<T>{result.getData(), result.getSize()}, expr, threshold);
+
+    return result;
+  }
+} // namespace matlabw::mx::expr
+
+#endif /* MATLABW_MX_EXPRESSION_HPP */
@@ -0,0 +1,288 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_MDSPAN_HPP
+#define MATLABW_MX_MDSPAN_HPP
+
+#include "detail/include.hpp"
+
+#include "common.hpp"
+#include "Exception.hpp"
+
+#ifndef MATLABW_HAS_MDSPAN
+# include "detail/mdspan.hpp"
+#endif
+
+namespace matlabw::mx
+{
+#ifdef MATLABW_HAS_MDSPAN
+  /**
+   * @brief Extents with all dimensions dynamic.
+   * @tparam rank The rank.
+   */
+  template<std::size_t rank>
+  using Dextents = std::dextents<std::size_t, rank>;
+
+  /**
+   * @brief Extents with static dimensions. Use std::dynamic_extent for dynamic dimensions.
+   * @tparam exts The extents.
+   */
+  template<std::size_t... exts>
+  using Extents = std::extents<std::size_t, exts...>;
+
+  /// @brief Column-major (MATLAB) layout.
+  using LayoutLeft = LayoutLeft;
+
+  /// @brief Strided layout.
+  using LayoutStride = LayoutStride;
+
+  /**
+   * @brief A multidimensional span of elements stored in MATLAB (column-major) order.
+   * @tparam T The type of the elements.
+   * @tparam E The extents type.
+   * @tparam L The layout type.
+   */
+  template<typename T, typename E, typename L = LayoutLeft>
+  using Mdspan = std::mdspan<T, E, L>;
+#else
+  /**
+   * @brief Extents with all dimensions dynamic.
+   * @tparam rank The rank.
+   */
+  template<std::size_t rank>
+  using Dextents = detail::MdDextents<rank>;
+
+  /**
+   * @brief Extents with static dimensions. Use std::dynamic_extent for dynamic dimensions.
+   * @tparam exts The extents.
+   */
+  template<std::size_t... exts>
+  using Extents = detail::MdExtents<exts...>;
+
+  /// @brief Column-major (MATLAB) layout.
+  using LayoutLeft = detail::MdLayoutLeft;
+
+  /// @brief Strided layout.
+  using LayoutStride = detail::MdLayoutStride;
+
+  /**
+   * @brief A multidimensional span of elements stored in MATLAB (column-major) order. The C++20 replacement of
+   *        std::mdspan, access the elements with md[std::array{i, j}] to stay compatible with both.
+   * @tparam T The type of the elements.
+   * @tparam E The extents type.
+   * @tparam L The layout type.
+   */
+  template<typename T, typename E, typename L = LayoutLeft>
+  using Mdspan = detail::Mdspan<T, E, L>;
+#endif
+
+  /**
+   * @brief A multidimensional span of constant elements stored in MATLAB (column-major) order.
+   * @tparam T The type of the elements.
+   * @tparam E The extents type.
+   * @tparam L The layout type.
+   */
+  template<typename T, typename E, typename L = LayoutLeft>
+  using Mdview = Mdspan<const T, E, L>;
+
+namespace detail
+{
+  /**
+   * @brief Makes the extents from MATLAB array dimensions. Missing dimensions are treated as singleton and trailing
+   *        dimensions that exceed the rank are folded into the last extent, as MATLAB does for indexing.
+   * @tparam E The extents type.
+   * @param dims The MATLAB array dimensions.
+   * @return The extents.
+   */
+  template<typename E>
+  [[nodiscard]] E makeExtents(View<std::size_t> dims)
+  {
+    static constexpr char id[]{"matlabw:mx:asMdspan"};
+
+    std::array<std::size_t, E::rank()> exts{};
+
+    if constexpr (E::rank() == 0)
+    {
+      if (std::accumulate(dims.begin(), dims.end(), std::size_t{1}, std::multiplies<>{}) != 1)
+      {
+        throw Exception{id, "array must be a scalar for rank 0 mdspan"};
+      }
+    }
+    else
+    {
+      for (std::size_t r{}; r < E::rank(); ++r)
+      {
+        exts[r] = (r < dims.size()) ? dims[r] : 1;
+      }
+
+      for (std::size_t r{E::rank()}; r < dims.size(); ++r)
+      {
+        exts[E::rank() - 1] *= dims[r];
+      }
+
+      for (std::size_t r{}; r < E::rank(); ++r)
+      {
+        if (E::static_extent(r) != std::dynamic_extent && E::static_extent(r) != exts[r])
+        {
+          throw Exception{id, "array dimensions do not match the static extents"};
+        }
+      }
+    }
+
+    return E{exts};
+  }
+
+  /**
+   * @brief Computes the offset of the trailing indices of a mdspan.
+   * @tparam M The mdspan type.
+   * @tparam Indices The index types.
+   * @param md The mdspan.
+   * @param first The first fixed dimension.
+   * @param indices The indices of the trailing dimensions.
+   * @return The offset.
+   */
+  template<typename M, typename... Indices>
+  [[nodiscard]] std::size_t getTrailingOffset(const M& md, std::size_t first, Indices... indices)
+  {
+    const std::array<std::size_t, sizeof...(Indices)> idx{static_cast<std::size_t>(indices)...};
+
+    std::size_t offset{};
+
+    for (std::size_t r{}; r < idx.size(); ++r)
+    {
+      if (idx[r] >= static_cast<std::size_t>(md.extent(first + r)))
+      {
+        throw Exception{"matlabw:mx:mdspan", "index out of range"};
+      }
+
+      offset += idx[r] * static_cast<std::size_t>(md.stride(first + r));
+    }
+
+    return offset;
+  }
+} // namespace detail
+
+  /**
+   * @brief Gets a column of a column-major mdspan. The column is contiguous.
+   * @tparam T The type of the elements.
+   * @tparam E The extents type.
+   * @tparam Indices The index types.
+   * @param md The mdspan.
+   * @param indices The indices of all dimensions except the first one.
+   * @return The column.
+   */
+  template<typename T, typename E, typename... Indices>
+  [[nodiscard]] Mdspan<T, Dextents<1>> getColumn(const Mdspan<T, E>& md, Indices... indices)
+  {
+    static_assert(sizeof...(Indices) + 1 == E::rank(), "indices must be specified for all but the first dimension");
+
+    return Mdspan<T, Dextents<1>>{md.data_handle() + detail::getTrailingOffset(md, 1, indices...),
+                                  Dextents<1>{md.extent(0)}};
+  }
+
+  /**
+   * @brief Gets a page (matrix) of a column-major mdspan. The page is contiguous.
+   * @tparam T The type of the elements.
+   * @tparam E The extents type.
+   * @tparam Indices The index types.
+   * @param md The mdspan.
+   * @param indices The indices of all dimensions except the first two.
+   * @return The page.
+   */
+  template<typename T, typename E, typename... Indices>
+  [[nodiscard]] Mdspan<T, Dextents<2>> getPage(const Mdspan<T, E>& md, Indices... indices)
+  {
+    static_assert(sizeof...(Indices) + 2 == E::rank(), "indices must be specified for all but the first two dimensions");
+
+    return Mdspan<T, Dextents<2>>{md.data_handle() + detail::getTrailingOffset(md, 2, indices...),
+                                  Dextents<2>{md.extent(0), md.extent(1)}};
+  }
+
+  /**
+   * @brief Gets a row of a column-major mdspan. The row elements are strided by the number of rows.
+   * @tparam T The type of the elements.
+   * @tparam E The extents type.
+   * @tparam Indices The index types.
+   * @param md The mdspan.
+   * @param i The row index.
+   * @param indices The indices of all dimensions except the first two.
+   * @return The row.
+   */
+  template<typename T, typename E, typename... Indices>
+  [[nodiscard]] Mdspan<T, Dextents<1>, LayoutStride> getRow(const Mdspan<T, E>& md, std::size_t i, Indices... indices)
+  {
+    static_assert(sizeof...(Indices) + 2 == E::rank(), "indices must be specified for all but the second dimension");
+
+    if (i >= static_cast<std::size_t>(md.extent(0)))
+    {
+      throw Exception{"matlabw:mx:getRow", "index out of range"};
+    }
+
+    using Mapping = LayoutStride::mapping<Dextents<1>>;
+
+    return Mdspan<T, Dextents<1>, LayoutStride>{
+      md.data_handle() + i + detail::getTrailingOffset(md, 2, indices...),
+      Mapping{Dextents<1>{md.extent(1)}, std::array<std::size_t, 1>{static_cast<std::size_t>(md.stride(1))}}};
+  }
+
+  /**
+   * @brief Gets a block of a mdspan. The block keeps the strides of the original mdspan.
+   * @tparam T The type of the elements.
+   * @tparam E The extents type.
+   * @tparam L The layout type.
+   * @param md The mdspan.
+   * @param offsets The offsets of the block.
+   * @param exts The extents of the block.
+   * @return The block.
+   */
+  template<typename T, typename E, typename L>
+  [[nodiscard]] Mdspan<T, Dextents<E::rank()>, LayoutStride>
+  getBlock(const Mdspan<T, E, L>&                   md,
+           const std::array<std::size_t, E::rank()>& offsets,
+           const std::array<std::size_t, E::rank()>& exts)
+  {
+    std::array<std::size_t, E::rank()> strides{};
+
+    std::size_t offset{};
+
+    for (std::size_t r{}; r < E::rank(); ++r)
+    {
+      if (offsets[r] > static_cast<std::size_t>(md.extent(r))
+          || exts[r] > static_cast<std::size_t>(md.extent(r)) - offsets[r])
+      {
+        throw Exception{"matlabw:mx:getBlock", "block out of range"};
+      }
+
+      strides[r] = static_cast<std::size_t>(md.stride(r));
+      offset    += offsets[r] * strides[r];
+    }
+
+    using Mapping = LayoutStride::mapping<Dextents<E::rank()>>;
+
+    return Mdspan<T, Dextents<E::rank()>, LayoutStride>{md.data_handle() + offset,
+                                                             Mapping{Dextents<E::rank()>{exts}, strides}};
+  }
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_MDSPAN_HPP */
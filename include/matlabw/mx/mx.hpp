@@ -31,25 +31,44 @@
 # error "This library requires MATLAB R2018a or later."
 #endif
 
+#include "Arena.hpp"
 #include "Array.hpp"
 #include "ArrayRef.hpp"
+#include "CancellationToken.hpp"
 #include "CellArray.hpp"
 #include "CellArrayRef.hpp"
+#include "cellstr.hpp"
 #include "CharArray.hpp"
 #include "CharArrayRef.hpp"
 #include "common.hpp"
+#include "complex.hpp"
+#include "convert.hpp"
 #include "Exception.hpp"
+#include "expression.hpp"
+#include "FieldAccessor.hpp"
+#include "FixedString.hpp"
 #include "limits.hpp"
+#include "mdspan.hpp"
 #include "LogicalArray.hpp"
 #include "memory.hpp"
 #include "NumericArray.hpp"
 #include "NumericArrayRef.hpp"
 #include "ObjectArray.hpp"
+#include "parallel.hpp"
 #include "propery.hpp"
+#include "reduce.hpp"
+#include "reflect.hpp"
+#include "SparseArray.hpp"
+#include "SparseArrayRef.hpp"
 #include "StructArray.hpp"
+#include "StructArrayBuilder.hpp"
 #include "StructArrayRef.hpp"
+#include "TaskGroup.hpp"
+#include "threadCheck.hpp"
+#include "ThreadPool.hpp"
 #include "TypedArray.hpp"
 #include "TypedArrayRef.hpp"
+#include "TypedArraySnapshot.hpp"
 #include "typeTraits.hpp"
 #include "visit.hpp"
 
@@ -0,0 +1,215 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_PARALLEL_HPP
+#define MATLABW_MX_PARALLEL_HPP
+
+#include "detail/include.hpp"
+#include "detail/parallel.hpp"
+
+#include "CancellationToken.hpp"
+#include "Exception.hpp"
+#include "ThreadPool.hpp"
+
+namespace matlabw::mx::parallel
+{
+  /// @brief Default minimum number of elements processed by a single task.
+  inline constexpr std::size_t defaultGrainSize{4096};
+
+  /**
+   * @brief Calls fn(element) for each element of a contiguous range, e.g. a TypedArrayRef or a span, on the shared
+   *        thread pool. The range is split into cache-line-aligned chunks. The callable must not call into the
+   *        MATLAB API.
+   * @tparam R The contiguous range type.
+   * @tparam Fn The callable type.
+   * @param range The range.
+   * @param fn The callable.
+   * @param grainSize The minimum number of elements processed by a single task.
+   */
+  template<std::ranges::contiguous_range R, typename Fn>
+  void forEach(R&& range, Fn&& fn, std::size_t grainSize = defaultGrainSize)
+  {
+    using T = std::ranges::range_value_t<R>;
+
+    auto* data = std::ranges::data(range);
+
+    mx::detail::parallelFor<T>(static_cast<std::size_t>(std::ranges::size(range)), [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        std::invoke(fn, data[i]);
+      }
+    }, grainSize);
+  }
+
+  /**
+   * @brief Calls fn(element) for each element of a contiguous range on the shared thread pool and polls the
+   *        cancellation token every token.getCheckInterval() elements. The callable must not call into the MATLAB API.
+   * @tparam R The contiguous range type.
+   * @tparam Fn The callable type.
+   * @param range The range.
+   * @param fn The callable.
+   * @param token The cancellation token, mx::Exception is thrown once cancellation has been requested.
+   * @param grainSize The minimum number of elements processed by a single task.
+   */
+  template<std::ranges::contiguous_range R, typename Fn>
+  void forEach(R&& range, Fn&& fn, CancellationToken& token, std::size_t grainSize = defaultGrainSize)
+  {
+    using T = std::ranges::range_value_t<R>;
+
+    auto* data = std::ranges::data(range);
+
+    mx::detail::parallelFor<T>(static_cast<std::size_t>(std::ranges::size(range)), [&](std::size_t begin, std::size_t end)
+    {
+      mx::detail::forEachCancellableBlock(begin, end, token, [&](std::size_t blockBegin, std::size_t blockEnd)
+      {
+        for (std::size_t i = blockBegin; i < blockEnd; ++i)
+        {
+          std::invoke(fn, data[i]);
+        }
+      });
+    }, grainSize);
+  }
+
+  /**
+   * @brief Stores fn(input element) to the corresponding output element for contiguous ranges, e.g. TypedArrayRef or
+   *        spans, on the shared thread pool. The ranges may alias. The callable must not call into the MATLAB API.
+   * @tparam In The input contiguous range type.
+   * @tparam Out The output contiguous range type.
+   * @tparam Fn The callable type.
+   * @param input The input range.
+   * @param output The output range, must have the same size as the input range.
+   * @param fn The callable.
+   * @param grainSize The minimum number of elements processed by a single task.
+   */
+  template<std::ranges::contiguous_range In, std::ranges::contiguous_range Out, typename Fn>
+  void transform(In&& input, Out&& output, Fn&& fn, std::size_t grainSize = defaultGrainSize)
+  {
+    using T = std::ranges::range_value_t<Out>;
+
+    const std::size_t n = static_cast<std::size_t>(std::ranges::size(input));
+
+    if (static_cast<std::size_t>(std::ranges::size(output)) != n)
+    {
+      throw Exception{"matlabw:mx:parallel:transform", "size mismatch"};
+    }
+
+    auto* src = std::ranges::data(input);
+    auto* dst = std::ranges::data(output);
+
+    mx::detail::parallelFor<T>(n, [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        dst[i] = std::invoke(fn, src[i]);
+      }
+    }, grainSize);
+  }
+
+  /**
+   * @brief Stores fn(input element) to the corresponding output element for contiguous ranges on the shared thread
+   *        pool and polls the cancellation token every token.getCheckInterval() elements. The ranges may alias. The
+   *        callable must not call into the MATLAB API.
+   * @tparam In The input contiguous range type.
+   * @tparam Out The output contiguous range type.
+   * @tparam Fn The callable type.
+   * @param input The input range.
+   * @param output The output range, must have the same size as the input range.
+   * @param fn The callable.
+   * @param token The cancellation token, mx::Exception is thrown once cancellation has been requested.
+   * @param grainSize The minimum number of elements processed by a single task.
+   */
+  template<std::ranges::contiguous_range In, std::ranges::contiguous_range Out, typename Fn>
+  void transform(In&& input, Out&& output, Fn&& fn, CancellationToken& token, std::size_t grainSize = defaultGrainSize)
+  {
+    using T = std::ranges::range_value_t<Out>;
+
+    const std::size_t n = static_cast<std::size_t>(std::ranges::size(input));
+
+    if (static_cast<std::size_t>(std::ranges::size(output)) != n)
+    {
+      throw Exception{"matlabw:mx:parallel:transform", "size mismatch"};
+    }
+
+    auto* src = std::ranges::data(input);
+    auto* dst = std::ranges::data(output);
+
+    mx::detail::parallelFor<T>(n, [&](std::size_t begin, std::size_t end)
+    {
+      mx::detail::forEachCancellableBlock(begin, end, token, [&](std::size_t blockBegin, std::size_t blockEnd)
+      {
+        for (std::size_t i = blockBegin; i < blockEnd; ++i)
+        {
+          dst[i] = std::invoke(fn, src[i]);
+        }
+      });
+    }, grainSize);
+  }
+
+  /**
+   * @brief Calls fn(i) for each index i in [0, n) on the shared thread pool. The callable must not call into the
+   *        MATLAB API.
+   * @tparam Fn The callable type.
+   * @param n The number of indices.
+   * @param fn The callable.
+   * @param grainSize The minimum number of indices processed by a single task.
+   */
+  template<typename Fn>
+  void forEachIndex(std::size_t n, Fn&& fn, std::size_t grainSize = defaultGrainSize)
+  {
+    mx::detail::parallelFor<std::byte>(n, [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        std::invoke(fn, i);
+      }
+    }, grainSize);
+  }
+
+  /**
+   * @brief Calls fn(i) for each index i in [0, n) on the shared thread pool and polls the cancellation token every
+   *        token.getCheckInterval() indices. The callable must not call into the MATLAB API.
+   * @tparam Fn The callable type.
+   * @param n The number of indices.
+   * @param fn The callable.
+   * @param token The cancellation token, mx::Exception is thrown once cancellation has been requested.
+   * @param grainSize The minimum number of indices processed by a single task.
+   */
+  template<typename Fn>
+  void forEachIndex(std::size_t n, Fn&& fn, CancellationToken& token, std::size_t grainSize = defaultGrainSize)
+  {
+    mx::detail::parallelFor<std::byte>(n, [&](std::size_t begin, std::size_t end)
+    {
+      mx::detail::forEachCancellableBlock(begin, end, token, [&](std::size_t blockBegin, std::size_t blockEnd)
+      {
+        for (std::size_t i = blockBegin; i < blockEnd; ++i)
+        {
+          std::invoke(fn, i);
+        }
+      });
+    }, grainSize);
+  }
+} // namespace matlabw::mx::parallel
+
+#endif /* MATLABW_MX_PARALLEL_HPP */
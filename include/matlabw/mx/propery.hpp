@@ -44,6 +44,8 @@ namespace matlabw::mx
                                                             const std::size_t index,
                                                             const char* const propName)
   {
+    checkThread("matlabw:mx:getProperty");
+
     if (propName == nullptr)
     {
       throw Exception{"property name must not be null"};
@@ -109,6 +111,8 @@ namespace matlabw::mx
                           const char* const propName,
                           const ArrayCref   value)
   {
+    checkThread("matlabw:mx:setProperty");
+
     if (propName == nullptr)
     {
       throw Exception{"property name must not be null"};
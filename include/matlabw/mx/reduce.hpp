@@ -0,0 +1,1197 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_REDUCE_HPP
+#define MATLABW_MX_REDUCE_HPP
+
+#include "detail/include.hpp"
+#include "detail/parallel.hpp"
+
+#include "convert.hpp"
+#include "Exception.hpp"
+#include "LogicalArray.hpp"
+#include "NumericArray.hpp"
+#include "NumericArrayRef.hpp"
+#include "ThreadPool.hpp"
+#include "typeTraits.hpp"
+
+namespace matlabw::mx::reduce
+{
+  /// @brief NaN handling of the reductions.
+  enum class NanFlag
+  {
+    include, ///< NaN values propagate to the result.
+    omit,    ///< NaN values are ignored.
+  };
+
+  /// @brief Summation algorithm.
+  enum class SumMethod
+  {
+    pairwise, ///< Pairwise summation of blocks, O(log n) error growth.
+    kahan,    ///< Kahan compensated summation, O(1) error growth at roughly twice the cost.
+  };
+
+  /// @brief Options of sum, mean and norm.
+  struct SumOptions
+  {
+    NanFlag   nanFlag{NanFlag::include};   ///< NaN handling, MATLAB includes NaN by default.
+    SumMethod method{SumMethod::pairwise}; ///< Summation algorithm.
+  };
+
+  namespace detail
+  {
+    using mx::detail::ComponentType;
+
+    /// @brief Number of independent accumulators of the contiguous kernels, lets the compiler vectorize them.
+    inline constexpr std::size_t laneCount{8};
+
+    /// @brief Number of elements summed directly before the pairwise summation splits the range.
+    inline constexpr std::size_t pairwiseBlockSize{128};
+
+    /// @brief Number of adjacent outputs reduced together along higher dimensions, keeps the accumulators in L1.
+    inline constexpr std::size_t tileSize{256};
+
+    /// @brief Maximum number of partial results of a reduction over all elements.
+    inline constexpr std::size_t maxPartialCount{64};
+
+    /**
+     * @brief Checks if the elements can be summed, i.e. real numeric, logical or complex floating-point.
+     * @tparam T The element type.
+     */
+    template<typename T>
+    inline constexpr bool isSummable = isRealNumeric<T> || std::is_same_v<T, bool> ||
+                                       (isComplexNumeric<T> && std::is_floating_point_v<typename ComponentType<T>::type>);
+
+    /**
+     * @brief Accumulator type, integers and logicals are accumulated in double.
+     * @tparam T The element type.
+     */
+    template<typename T>
+    using Accumulator = std::conditional_t<std::is_integral_v<T>, double, T>;
+
+    /**
+     * @brief Checks if a value is NaN, for complex values if any component is NaN.
+     * @tparam T The value type.
+     * @param value The value.
+     * @return True if the value is NaN.
+     */
+    template<typename T>
+    [[nodiscard]] constexpr bool isNan(const T& value) noexcept
+    {
+      if constexpr (isComplexNumeric<T>)
+      {
+        return isNan(value.real()) || isNan(value.imag());
+      }
+      else
+      {
+        return value != value;
+      }
+    }
+
+    /**
+     * @brief Checks if a value is nonzero, NaN is nonzero.
+     * @tparam T The value type.
+     * @param value The value.
+     * @return True if the value is nonzero.
+     */
+    template<typename T>
+    [[nodiscard]] constexpr bool isNonzero(const T& value) noexcept
+    {
+      return value != T{};
+    }
+
+    /**
+     * @brief Adds a value to a compensated sum.
+     * @tparam Acc The accumulator type.
+     * @param sum The sum.
+     * @param compensation The running compensation of the lost low-order bits.
+     * @param value The value.
+     */
+    template<typename Acc>
+    void kahanAdd(Acc& sum, Acc& compensation, Acc value) noexcept
+    {
+      const Acc y = value - compensation;
+      const Acc t = sum + y;
+
+      compensation = (t - sum) - y;
+      sum          = t;
+    }
+
+    /**
+     * @brief Sums the lanes in a balanced tree.
+     * @tparam Acc The accumulator type.
+     * @param lanes The lanes.
+     * @return The sum.
+     */
+    template<typename Acc>
+    [[nodiscard]] Acc sumLanes(const Acc (&lanes)[laneCount]) noexcept
+    {
+      return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    }
+
+    /**
+     * @brief Sum of mapped elements, the common kernel of sum, mean, norm and the NaN count. Contiguous ranges are
+     *        summed with independent lanes, strided ranges tile by tile with one accumulator per output.
+     * @tparam T The element type.
+     * @tparam Acc The accumulator type.
+     * @tparam Map The element mapping, returns Acc.
+     */
+    template<typename T, typename Acc, typename Map>
+    struct SumReducer
+    {
+      using Result = Acc; ///< The partial result type.
+
+      SumMethod method{}; ///< The summation algorithm.
+      Map       map{};    ///< The element mapping.
+
+      /**
+       * @brief Reduces a contiguous range.
+       * @param x The elements.
+       * @param n The number of elements.
+       * @return The sum.
+       */
+      [[nodiscard]] Acc operator()(const T* x, std::size_t n) const noexcept
+      {
+        return (method == SumMethod::kahan) ? kahanSum(x, n) : pairwiseSum(x, n);
+      }
+
+      /**
+       * @brief Reduces the rows of a column-major tile, out[i] = sum over k of x[k * stride + i].
+       * @param x The first element of the tile.
+       * @param stride The distance between two rows.
+       * @param len The number of rows.
+       * @param width The number of columns, at most tileSize.
+       * @param out The results.
+       */
+      void operator()(const T* x, std::size_t stride, std::size_t len, std::size_t width, Acc* out) const
+      {
+        if (method == SumMethod::kahan)
+        {
+          Acc compensation[tileSize]{};
+
+          std::fill_n(out, width, Acc{});
+
+          for (std::size_t k{}; k < len; ++k)
+          {
+            const T* row = x + k * stride;
+
+            for (std::size_t i{}; i < width; ++i)
+            {
+              kahanAdd(out[i], compensation[i], map(row[i]));
+            }
+          }
+
+          return;
+        }
+
+        if (len <= pairwiseBlockSize)
+        {
+          sumRows(x, stride, len, width, out);
+          return;
+        }
+
+        // cascade of block sums merged like a binary counter, level l holds the sum of 2^l blocks
+        Acc              block[tileSize];
+        std::vector<Acc> levels{};
+        std::uint64_t    occupied{};
+
+        for (std::size_t k{}; k < len; k += pairwiseBlockSize)
+        {
+          sumRows(x + k * stride, stride, std::min(pairwiseBlockSize, len - k), width, block);
+
+          std::size_t level{};
+
+          for (; (occupied >> level) & 1; ++level)
+          {
+            const Acc* stored = levels.data() + level * width;
+
+            for (std::size_t i{}; i < width; ++i)
+            {
+              block[i] = stored[i] + block[i];
+            }
+
+            occupied &= ~(std::uint64_t{1} << level);
+          }
+
+          levels.resize(std::max(levels.size(), (level + 1) * width));
+          std::copy_n(block, width, levels.data() + level * width);
+          occupied |= std::uint64_t{1} << level;
+        }
+
+        std::fill_n(out, width, Acc{});
+
+        for (std::size_t level{}; occupied >> level; ++level)
+        {
+          if ((occupied >> level) & 1)
+          {
+            const Acc* stored = levels.data() + level * width;
+
+            for (std::size_t i{}; i < width; ++i)
+            {
+              out[i] = stored[i] + out[i];
+            }
+          }
+        }
+      }
+
+      /**
+       * @brief Combines two partial results.
+       * @param a The first partial result.
+       * @param b The second partial result.
+       * @return The combined result.
+       */
+      [[nodiscard]] static Acc combine(Acc a, Acc b) noexcept
+      {
+        return a + b;
+      }
+
+      /**
+       * @brief Pairwise sum of a contiguous range.
+       * @param x The elements.
+       * @param n The number of elements.
+       * @return The sum.
+       */
+      [[nodiscard]] Acc pairwiseSum(const T* x, std::size_t n) const noexcept
+      {
+        if (n > pairwiseBlockSize)
+        {
+          const std::size_t half = n / 2 / laneCount * laneCount;
+
+          return pairwiseSum(x, half) + pairwiseSum(x + half, n - half);
+        }
+
+        Acc lanes[laneCount]{};
+
+        std::size_t i{};
+
+        for (; i + laneCount <= n; i += laneCount)
+        {
+          for (std::size_t j{}; j < laneCount; ++j)
+          {
+            lanes[j] += map(x[i + j]);
+          }
+        }
+
+        for (; i < n; ++i)
+        {
+          lanes[i % laneCount] += map(x[i]);
+        }
+
+        return sumLanes(lanes);
+      }
+
+      /**
+       * @brief Kahan sum of a contiguous range.
+       * @param x The elements.
+       * @param n The number of elements.
+       * @return The sum.
+       */
+      [[nodiscard]] Acc kahanSum(const T* x, std::size_t n) const noexcept
+      {
+        Acc sums[laneCount]{};
+        Acc compensations[laneCount]{};
+
+        std::size_t i{};
+
+        for (; i + laneCount <= n; i += laneCount)
+        {
+          for (std::size_t j{}; j < laneCount; ++j)
+          {
+            kahanAdd(sums[j], compensations[j], map(x[i + j]));
+          }
+        }
+
+        for (; i < n; ++i)
+        {
+          kahanAdd(sums[i % laneCount], compensations[i % laneCount], map(x[i]));
+        }
+
+        Acc sum{};
+        Acc compensation{};
+
+        for (std::size_t j{}; j < laneCount; ++j)
+        {
+          kahanAdd(sum, compensation, sums[j]);
+          kahanAdd(sum, compensation, -compensations[j]);
+        }
+
+        return sum;
+      }
+
+      /**
+       * @brief Plain sum of the rows of a tile, the base case of the pairwise summation.
+       * @param x The first element of the tile.
+       * @param stride The distance between two rows.
+       * @param len The number of rows.
+       * @param width The number of columns.
+       * @param out The results.
+       */
+      void sumRows(const T* x, std::size_t stride, std::size_t len, std::size_t width, Acc* out) const noexcept
+      {
+        std::fill_n(out, width, Acc{});
+
+        for (std::size_t k{}; k < len; ++k)
+        {
+          const T* row = x + k * stride;
+
+          for (std::size_t i{}; i < width; ++i)
+          {
+            out[i] += map(row[i]);
+          }
+        }
+      }
+    };
+
+    /**
+     * @brief Creates a sum reducer.
+     * @tparam T The element type.
+     * @tparam Acc The accumulator type.
+     * @tparam Map The element mapping type.
+     * @param method The summation algorithm.
+     * @param map The element mapping.
+     * @return The reducer.
+     */
+    template<typename T, typename Acc, typename Map>
+    [[nodiscard]] SumReducer<T, Acc, Map> makeSumReducer(SumMethod method, Map map)
+    {
+      return SumReducer<T, Acc, Map>{method, map};
+    }
+
+    /**
+     * @brief Partial result of min and max.
+     * @tparam T The element type.
+     */
+    template<typename T>
+    struct Extremum
+    {
+      T    value{};    ///< The extremum of the non-NaN values.
+      bool hasValue{}; ///< Set if a non-NaN value has been seen.
+      bool hasNan{};   ///< Set if a NaN value has been seen.
+    };
+
+    /**
+     * @brief Min or max of real elements. NaN values never win the comparison, the flags decide the NaN result.
+     * @tparam T The element type.
+     * @tparam isMax True for max, false for min.
+     */
+    template<typename T, bool isMax>
+    struct ExtremumReducer
+    {
+      using Result = Extremum<T>; ///< The partial result type.
+
+      /// @brief The identity of the comparison.
+      static constexpr T identity = []
+      {
+        if constexpr (std::numeric_limits<T>::has_infinity)
+        {
+          return isMax ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+        }
+        else
+        {
+          return isMax ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+        }
+      }();
+
+      /**
+       * @brief Selects the better of a candidate and the current value.
+       * @param candidate The candidate, may be NaN.
+       * @param current The current value.
+       * @return The candidate if it is better, otherwise the current value.
+       */
+      [[nodiscard]] static T select(T candidate, T current) noexcept
+      {
+        if constexpr (isMax)
+        {
+          return (candidate > current) ? candidate : current;
+        }
+        else
+        {
+          return (candidate < current) ? candidate : current;
+        }
+      }
+
+      /**
+       * @brief Reduces a contiguous range.
+       * @param x The elements.
+       * @param n The number of elements.
+       * @return The partial result.
+       */
+      [[nodiscard]] Result operator()(const T* x, std::size_t n) const noexcept
+      {
+        T    values[laneCount];
+        bool nans[laneCount]{};
+
+        std::fill_n(values, laneCount, identity);
+
+        std::size_t i{};
+
+        for (; i + laneCount <= n; i += laneCount)
+        {
+          for (std::size_t j{}; j < laneCount; ++j)
+          {
+            values[j] = select(x[i + j], values[j]);
+            nans[j]  |= isNan(x[i + j]);
+          }
+        }
+
+        for (; i < n; ++i)
+        {
+          values[0] = select(x[i], values[0]);
+          nans[0]  |= isNan(x[i]);
+        }
+
+        Result result{identity, false, false};
+
+        for (std::size_t j{}; j < laneCount; ++j)
+        {
+          result.value   = select(values[j], result.value);
+          result.hasNan |= nans[j];
+        }
+
+        result.hasValue = hasValue(x, n, result.hasNan);
+
+        return result;
+      }
+
+      /**
+       * @brief Reduces the rows of a column-major tile.
+       * @param x The first element of the tile.
+       * @param stride The distance between two rows.
+       * @param len The number of rows.
+       * @param width The number of columns, at most tileSize.
+       * @param out The partial results.
+       */
+      void operator()(const T* x, std::size_t stride, std::size_t len, std::size_t width, Result* out) const noexcept
+      {
+        T    values[tileSize];
+        bool nans[tileSize]{};
+        bool valid[tileSize]{};
+
+        std::fill_n(values, width, identity);
+
+        for (std::size_t k{}; k < len; ++k)
+        {
+          const T* row = x + k * stride;
+
+          for (std::size_t i{}; i < width; ++i)
+          {
+            values[i] = select(row[i], values[i]);
+            nans[i]  |= isNan(row[i]);
+            valid[i] |= !isNan(row[i]);
+          }
+        }
+
+        for (std::size_t i{}; i < width; ++i)
+        {
+          out[i] = Result{values[i], valid[i], nans[i]};
+        }
+      }
+
+      /**
+       * @brief Combines two partial results.
+       * @param a The first partial result.
+       * @param b The second partial result.
+       * @return The combined result.
+       */
+      [[nodiscard]] static Result combine(Result a, Result b) noexcept
+      {
+        return Result{select(b.value, a.value), a.hasValue || b.hasValue, a.hasNan || b.hasNan};
+      }
+
+      /**
+       * @brief Checks if a contiguous range contains a non-NaN value.
+       * @param x The elements.
+       * @param n The number of elements.
+       * @param hasNan Whether the range contains a NaN value.
+       * @return True if a non-NaN value exists.
+       */
+      [[nodiscard]] static bool hasValue(const T* x, std::size_t n, bool hasNan) noexcept
+      {
+        if (!hasNan)
+        {
+          return n != 0;
+        }
+
+        return std::any_of(x, x + n, [](T value) { return !isNan(value); });
+      }
+    };
+
+    /**
+     * @brief Any or all of the elements nonzero. Any ignores NaN values, all counts them as nonzero.
+     * @tparam T The element type.
+     * @tparam isAll True for all, false for any.
+     */
+    template<typename T, bool isAll>
+    struct LogicalReducer
+    {
+      using Result = bool; ///< The partial result type.
+
+      /// @brief Number of elements tested between two checks for an early exit.
+      static constexpr std::size_t blockSize{256};
+
+      /**
+       * @brief Tests an element.
+       * @param value The element.
+       * @return The test result.
+       */
+      [[nodiscard]] static bool test(const T& value) noexcept
+      {
+        if constexpr (isAll)
+        {
+          return isNonzero(value);
+        }
+        else
+        {
+          return isNonzero(value) && !isNan(value);
+        }
+      }
+
+      /**
+       * @brief Reduces a contiguous range, exits early once the result is known.
+       * @param x The elements.
+       * @param n The number of elements.
+       * @return The result.
+       */
+      [[nodiscard]] bool operator()(const T* x, std::size_t n) const noexcept
+      {
+        for (std::size_t begin{}; begin < n; begin += blockSize)
+        {
+          const std::size_t end = std::min(n, begin + blockSize);
+
+          bool result = isAll;
+
+          for (std::size_t i = begin; i < end; ++i)
+          {
+            if constexpr (isAll)
+            {
+              result &= test(x[i]);
+            }
+            else
+            {
+              result |= test(x[i]);
+            }
+          }
+
+          if (result != isAll)
+          {
+            return !isAll;
+          }
+        }
+
+        return isAll;
+      }
+
+      /**
+       * @brief Reduces the rows of a column-major tile.
+       * @param x The first element of the tile.
+       * @param stride The distance between two rows.
+       * @param len The number of rows.
+       * @param width The number of columns, at most tileSize.
+       * @param out The results.
+       */
+      void operator()(const T* x, std::size_t stride, std::size_t len, std::size_t width, bool* out) const noexcept
+      {
+        std::fill_n(out, width, isAll);
+
+        for (std::size_t k{}; k < len; ++k)
+        {
+          const T* row = x + k * stride;
+
+          for (std::size_t i{}; i < width; ++i)
+          {
+            if constexpr (isAll)
+            {
+              out[i] &= test(row[i]);
+            }
+            else
+            {
+              out[i] |= test(row[i]);
+            }
+          }
+        }
+      }
+
+      /**
+       * @brief Combines two partial results.
+       * @param a The first partial result.
+       * @param b The second partial result.
+       * @return The combined result.
+       */
+      [[nodiscard]] static bool combine(bool a, bool b) noexcept
+      {
+        return isAll ? (a && b) : (a || b);
+      }
+    };
+
+    /**
+     * @brief Reduces all elements. Large ranges are split into a number of chunks that depends on the size only, so
+     *        the result does not depend on the number of threads.
+     * @tparam Reducer The reducer type.
+     * @tparam T The element type.
+     * @param reducer The reducer.
+     * @param x The elements.
+     * @param n The number of elements.
+     * @return The result.
+     */
+    template<typename Reducer, typename T>
+    [[nodiscard]] typename Reducer::Result reduceAll(const Reducer& reducer, const T* x, std::size_t n)
+    {
+      using Result = typename Reducer::Result;
+
+      const std::size_t partialCount = std::min(n / mx::detail::parallelThreshold, maxPartialCount);
+
+      if (partialCount <= 1)
+      {
+        return reducer(x, n);
+      }
+
+      const std::size_t chunk = (n / partialCount + pairwiseBlockSize - 1) / pairwiseBlockSize * pairwiseBlockSize;
+
+      const std::size_t chunkCount = (n + chunk - 1) / chunk;
+
+      // not std::vector, std::vector<bool> packs the partials of logical reducers into shared words
+      const auto partials = std::make_unique<Result[]>(chunkCount);
+
+      getThreadPool().run(chunkCount, [&](std::size_t i)
+      {
+        partials[i] = reducer(x + i * chunk, std::min(chunk, n - i * chunk));
+      });
+
+      Result result = partials[0];
+
+      for (std::size_t i = 1; i < chunkCount; ++i)
+      {
+        result = Reducer::combine(result, partials[i]);
+      }
+
+      return result;
+    }
+
+    /**
+     * @brief Reduces column-major data viewed as an inner x len x outer block along the middle dimension. With
+     *        inner == 1 each output reduces a contiguous column, otherwise rows of adjacent outputs are reduced tile
+     *        by tile. Outputs are distributed over the shared thread pool above the parallel threshold.
+     * @tparam Reducer The reducer type.
+     * @tparam T The element type.
+     * @param reducer The reducer.
+     * @param x The elements.
+     * @param inner The product of the dimensions below the reduced one.
+     * @param len The reduced dimension.
+     * @param outer The product of the dimensions above the reduced one.
+     * @param out The inner x outer results.
+     */
+    template<typename Reducer, typename T>
+    void reduceBlock(const Reducer&            reducer,
+                     const T*                  x,
+                     std::size_t               inner,
+                     std::size_t               len,
+                     std::size_t               outer,
+                     typename Reducer::Result* out)
+    {
+      if (inner == 1)
+      {
+        if (outer == 1)
+        {
+          out[0] = reduceAll(reducer, x, len);
+          return;
+        }
+
+        mx::detail::parallelFor<std::byte>(outer, [&](std::size_t begin, std::size_t end)
+        {
+          for (std::size_t o = begin; o < end; ++o)
+          {
+            out[o] = reducer(x + o * len, len);
+          }
+        }, std::max(std::size_t{1}, mx::detail::parallelThreshold / std::max(len, std::size_t{1})));
+
+        return;
+      }
+
+      const std::size_t tileCount = (inner + tileSize - 1) / tileSize;
+      const std::size_t tileWork  = std::max(std::size_t{1}, len * std::min(inner, tileSize));
+
+      mx::detail::parallelFor<std::byte>(outer * tileCount, [&](std::size_t begin, std::size_t end)
+      {
+        for (std::size_t item = begin; item < end; ++item)
+        {
+          const std::size_t o     = item / tileCount;
+          const std::size_t first = (item % tileCount) * tileSize;
+
+          reducer(x + o * len * inner + first, inner, len, std::min(tileSize, inner - first), out + o * inner + first);
+        }
+      }, std::max(std::size_t{1}, mx::detail::parallelThreshold / tileWork));
+    }
+
+    /**
+     * @brief Reduces an array along a dimension and finalizes the partial results into a new array.
+     * @tparam Out The output element type.
+     * @tparam Reducer The reducer type.
+     * @tparam T The element type.
+     * @tparam Finalize The finalization type, converts a partial result to Out.
+     * @param array The array.
+     * @param dim The zero-based dimension.
+     * @param reducer The reducer.
+     * @param keepEmpty If true, an empty reduced dimension stays empty, otherwise it becomes a singleton.
+     * @param finalize The finalization.
+     * @return The reduced array.
+     */
+    template<typename Out, typename Reducer, typename T, typename Finalize>
+    [[nodiscard]] TypedArray<Out> reduceDim(TypedArrayCref<T> array,
+                                            std::size_t       dim,
+                                            const Reducer&    reducer,
+                                            bool              keepEmpty,
+                                            Finalize&&        finalize)
+    {
+      using Result = typename Reducer::Result;
+
+      const View<std::size_t> dims = array.getDims();
+
+      std::vector<std::size_t> outDims(dims.begin(), dims.end());
+
+      const std::size_t len   = (dim < dims.size()) ? dims[dim] : 1;
+      const std::size_t inner = std::accumulate(dims.begin(), dims.begin() + std::min(dim, dims.size()),
+                                                std::size_t{1}, std::multiplies<>{});
+      const std::size_t outer = (inner * len == 0) ? 0 : array.getSize() / (inner * len);
+
+      if (dim < outDims.size())
+      {
+        outDims[dim] = (keepEmpty && len == 0) ? 0 : 1;
+      }
+
+      const View<std::size_t> outDimsView{outDims.data(), outDims.size()};
+
+      TypedArray<Out> result = [&]
+      {
+        if constexpr (std::is_same_v<Out, bool>)
+        {
+          return makeLogicalArray(outDimsView);
+        }
+        else
+        {
+          return makeUninitNumericArray<Out>(outDimsView);
+        }
+      }();
+
+      Out*              dst  = result.getData();
+      const std::size_t size = result.getSize();
+
+      if (size == 0)
+      {
+        return result;
+      }
+
+      if (len == 0)
+      {
+        // reduction of an empty dimension yields the identity for each output
+        std::fill_n(dst, size, finalize(reducer(array.getData(), 0)));
+        return result;
+      }
+
+      if constexpr (std::is_same_v<Result, Out>)
+      {
+        reduceBlock(reducer, array.getData(), inner, len, outer, dst);
+
+        std::transform(dst, dst + size, dst, finalize);
+      }
+      else
+      {
+        std::vector<Result> partials(size);
+
+        reduceBlock(reducer, array.getData(), inner, len, outer, partials.data());
+
+        std::transform(partials.begin(), partials.end(), dst, finalize);
+      }
+
+      return result;
+    }
+  } // namespace detail
+
+  /**
+   * @brief Result type of sum, integers keep their class, logicals are summed to double.
+   * @tparam T The element type.
+   */
+  template<typename T>
+  using SumType = std::conditional_t<std::is_same_v<T, bool>, double, T>;
+
+  /**
+   * @brief Result type of mean, integers and logicals yield double.
+   * @tparam T The element type.
+   */
+  template<typename T>
+  using MeanType = std::conditional_t<std::is_integral_v<T>, double, T>;
+
+  /**
+   * @brief Result type of norm, the real component type.
+   * @tparam T The element type.
+   */
+  template<typename T>
+  using NormType = typename detail::ComponentType<T>::type;
+
+  namespace detail
+  {
+    /**
+     * @brief Creates the reducer of sum and mean.
+     * @tparam T The element type.
+     * @param options The options.
+     * @return The reducer.
+     */
+    template<typename T>
+    [[nodiscard]] auto makeSum(const SumOptions& options)
+    {
+      using Acc = Accumulator<T>;
+
+      const bool omitNan = (options.nanFlag == NanFlag::omit);
+
+      return makeSumReducer<T, Acc>(options.method, [omitNan](const T& value) noexcept
+      {
+        return (omitNan && isNan(value)) ? Acc{} : static_cast<Acc>(value);
+      });
+    }
+
+    /**
+     * @brief Creates the reducer counting the elements that are not NaN.
+     * @tparam T The element type.
+     * @return The reducer.
+     */
+    template<typename T>
+    [[nodiscard]] auto makeCount()
+    {
+      return makeSumReducer<T, double>(SumMethod::pairwise, [](const T& value) noexcept
+      {
+        return isNan(value) ? 0.0 : 1.0;
+      });
+    }
+
+    /**
+     * @brief Creates the reducer of the sum of squared magnitudes.
+     * @tparam T The element type.
+     * @param options The options.
+     * @return The reducer.
+     */
+    template<typename T>
+    [[nodiscard]] auto makeSumOfSquares(const SumOptions& options)
+    {
+      using Acc = NormType<T>;
+
+      const bool omitNan = (options.nanFlag == NanFlag::omit);
+
+      return makeSumReducer<T, Acc>(options.method, [omitNan](const T& value) noexcept
+      {
+        return (omitNan && isNan(value)) ? Acc{} : static_cast<Acc>(std::norm(value));
+      });
+    }
+
+    /**
+     * @brief Converts a sum accumulator to the result type, integers are rounded and saturated.
+     * @tparam T The element type.
+     * @param sum The sum.
+     * @return The result.
+     */
+    template<typename T>
+    [[nodiscard]] SumType<T> finalizeSum(Accumulator<T> sum) noexcept
+    {
+      if constexpr (std::is_integral_v<SumType<T>>)
+      {
+        return mx::detail::convertValue<SumType<T>>(sum);
+      }
+      else
+      {
+        return static_cast<SumType<T>>(sum);
+      }
+    }
+
+    /**
+     * @brief Converts a min or max partial result to the result value.
+     * @tparam T The element type.
+     * @param extremum The partial result.
+     * @param nanFlag The NaN handling.
+     * @return The result.
+     */
+    template<typename T>
+    [[nodiscard]] T finalizeExtremum(const Extremum<T>& extremum, NanFlag nanFlag) noexcept
+    {
+      if constexpr (std::numeric_limits<T>::has_quiet_NaN)
+      {
+        if (!extremum.hasValue || (extremum.hasNan && nanFlag == NanFlag::include))
+        {
+          return std::numeric_limits<T>::quiet_NaN();
+        }
+      }
+
+      return extremum.value;
+    }
+  } // namespace detail
+
+  /**
+   * @brief Sums the elements along a dimension.
+   * @tparam T The element type, real numeric, logical or complex floating-point.
+   * @param array The array.
+   * @param dim The zero-based dimension, dimensions past the rank are singletons.
+   * @param options The options.
+   * @return The array of sums, the reduced dimension has size 1.
+   */
+  template<typename T, std::enable_if_t<detail::isSummable<T>, int> = 0>
+  [[nodiscard]] TypedArray<SumType<T>> sum(TypedArrayCref<T> array, std::size_t dim, const SumOptions& options = {})
+  {
+    return detail::reduceDim<SumType<T>>(array, dim, detail::makeSum<T>(options), false, &detail::finalizeSum<T>);
+  }
+
+  /**
+   * @brief Sums all elements.
+   * @tparam T The element type, real numeric, logical or complex floating-point.
+   * @param array The array.
+   * @param options The options.
+   * @return The sum.
+   */
+  template<typename T, std::enable_if_t<detail::isSummable<T>, int> = 0>
+  [[nodiscard]] SumType<T> sum(TypedArrayCref<T> array, const SumOptions& options = {})
+  {
+    return detail::finalizeSum<T>(detail::reduceAll(detail::makeSum<T>(options), array.getData(), array.getSize()));
+  }
+
+  /**
+   * @brief Averages the elements along a dimension.
+   * @tparam T The element type, real numeric, logical or complex floating-point.
+   * @param array The array.
+   * @param dim The zero-based dimension, dimensions past the rank are singletons.
+   * @param options The options.
+   * @return The array of means, the reduced dimension has size 1.
+   */
+  template<typename T, std::enable_if_t<detail::isSummable<T>, int> = 0>
+  [[nodiscard]] TypedArray<MeanType<T>> mean(TypedArrayCref<T> array, std::size_t dim, const SumOptions& options = {})
+  {
+    using Acc = detail::Accumulator<T>;
+
+    const View<std::size_t> dims = array.getDims();
+
+    const bool   omitNan = (options.nanFlag == NanFlag::omit);
+    const double len     = static_cast<double>((dim < dims.size()) ? dims[dim] : 1);
+
+    // with omitted NaN the sums are divided by the per-output counts afterwards
+    const double divisor = omitNan ? 1.0 : len;
+
+    TypedArray<MeanType<T>> result = detail::reduceDim<MeanType<T>>(array, dim, detail::makeSum<T>(options), false,
+                                                                     [divisor](Acc sum) noexcept
+    {
+      return static_cast<MeanType<T>>(sum / static_cast<NormType<Acc>>(divisor));
+    });
+
+    if (omitNan)
+    {
+      TypedArray<double> counts = detail::reduceDim<double>(array, dim, detail::makeCount<T>(), false,
+                                                            [](double count) noexcept { return count; });
+
+      MeanType<T>*  dst   = result.getData();
+      const double* count = counts.getData();
+
+      for (std::size_t i{}; i < result.getSize(); ++i)
+      {
+        dst[i] /= static_cast<NormType<MeanType<T>>>(count[i]);
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Averages all elements.
+   * @tparam T The element type, real numeric, logical or complex floating-point.
+   * @param array The array.
+   * @param options The options.
+   * @return The mean, NaN for an empty array.
+   */
+  template<typename T, std::enable_if_t<detail::isSummable<T>, int> = 0>
+  [[nodiscard]] MeanType<T> mean(TypedArrayCref<T> array, const SumOptions& options = {})
+  {
+    using Acc = detail::Accumulator<T>;
+
+    const T*          x = array.getData();
+    const std::size_t n = array.getSize();
+
+    const Acc    sum   = detail::reduceAll(detail::makeSum<T>(options), x, n);
+    const double count = (options.nanFlag == NanFlag::omit) ? detail::reduceAll(detail::makeCount<T>(), x, n)
+                                                              : static_cast<double>(n);
+
+    return static_cast<MeanType<T>>(sum / static_cast<NormType<Acc>>(count));
+  }
+
+  /**
+   * @brief Computes the 2-norm of the vectors along a dimension, like vecnorm. The squares are summed without
+   *        scaling, so values beyond the square root of the largest finite value overflow.
+   * @tparam T The element type, real or complex floating-point.
+   * @param array The array.
+   * @param dim The zero-based dimension, dimensions past the rank are singletons.
+   * @param options The options.
+   * @return The array of norms, the reduced dimension has size 1.
+   */
+  template<typename T, std::enable_if_t<std::is_floating_point_v<NormType<T>> && isNumeric<T>, int> = 0>
+  [[nodiscard]] TypedArray<NormType<T>> norm(TypedArrayCref<T> array, std::size_t dim, const SumOptions& options = {})
+  {
+    return detail::reduceDim<NormType<T>>(array, dim, detail::makeSumOfSquares<T>(options), false,
+                                          [](NormType<T> sumOfSquares) noexcept { return std::sqrt(sumOfSquares); });
+  }
+
+  /**
+   * @brief Computes the 2-norm of all elements, like norm(A(:)).
+   * @tparam T The element type, real or complex floating-point.
+   * @param array The array.
+   * @param options The options.
+   * @return The norm.
+   */
+  template<typename T, std::enable_if_t<std::is_floating_point_v<NormType<T>> && isNumeric<T>, int> = 0>
+  [[nodiscard]] NormType<T> norm(TypedArrayCref<T> array, const SumOptions& options = {})
+  {
+    return std::sqrt(detail::reduceAll(detail::makeSumOfSquares<T>(options), array.getData(), array.getSize()));
+  }
+
+  /**
+   * @brief Finds the minimum along a dimension. MATLAB omits NaN by default, the result is NaN only if all values
+   *        are NaN.
+   * @tparam T The real numeric element type.
+   * @param array The array.
+   * @param dim The zero-based dimension, dimensions past the rank are singletons.
+   * @param nanFlag The NaN handling.
+   * @return The array of minima, the reduced dimension has size 1, or 0 if it was empty.
+   */
+  template<typename T, std::enable_if_t<isRealNumeric<T>, int> = 0>
+  [[nodiscard]] TypedArray<T> min(TypedArrayCref<T> array, std::size_t dim, NanFlag nanFlag = NanFlag::omit)
+  {
+    return detail::reduceDim<T>(array, dim, detail::ExtremumReducer<T, false>{}, true,
+                                [nanFlag](const detail::Extremum<T>& e) noexcept
+    {
+      return detail::finalizeExtremum(e, nanFlag);
+    });
+  }
+
+  /**
+   * @brief Finds the minimum of all elements.
+   * @tparam T The real numeric element type.
+   * @param array The non-empty array.
+   * @param nanFlag The NaN handling.
+   * @return The minimum.
+   */
+  template<typename T, std::enable_if_t<isRealNumeric<T>, int> = 0>
+  [[nodiscard]] T min(TypedArrayCref<T> array, NanFlag nanFlag = NanFlag::omit)
+  {
+    if (array.isEmpty())
+    {
+      throw Exception{"matlabw:mx:reduce:min", "array must not be empty"};
+    }
+
+    return detail::finalizeExtremum(detail::reduceAll(detail::ExtremumReducer<T, false>{}, array.getData(),
+                                                      array.getSize()), nanFlag);
+  }
+
+  /**
+   * @brief Finds the maximum along a dimension. MATLAB omits NaN by default, the result is NaN only if all values
+   *        are NaN.
+   * @tparam T The real numeric element type.
+   * @param array The array.
+   * @param dim The zero-based dimension, dimensions past the rank are singletons.
+   * @param nanFlag The NaN handling.
+   * @return The array of maxima, the reduced dimension has size 1, or 0 if it was empty.
+   */
+  template<typename T, std::enable_if_t<isRealNumeric<T>, int> = 0>
+  [[nodiscard]] TypedArray<T> max(TypedArrayCref<T> array, std::size_t dim, NanFlag nanFlag = NanFlag::omit)
+  {
+    return detail::reduceDim<T>(array, dim, detail::ExtremumReducer<T, true>{}, true,
+                                [nanFlag](const detail::Extremum<T>& e) noexcept
+    {
+      return detail::finalizeExtremum(e, nanFlag);
+    });
+  }
+
+  /**
+   * @brief Finds the maximum of all elements.
+   * @tparam T The real numeric element type.
+   * @param array The non-empty array.
+   * @param nanFlag The NaN handling.
+   * @return The maximum.
+   */
+  template<typename T, std::enable_if_t<isRealNumeric<T>, int> = 0>
+  [[nodiscard]] T max(TypedArrayCref<T> array, NanFlag nanFlag = NanFlag::omit)
+  {
+    if (array.isEmpty())
+    {
+      throw Exception{"matlabw:mx:reduce:max", "array must not be empty"};
+    }
+
+    return detail::finalizeExtremum(detail::reduceAll(detail::ExtremumReducer<T, true>{}, array.getData(),
+                                                      array.getSize()), nanFlag);
+  }
+
+  /**
+   * @brief Tests if any element along a dimension is nonzero, NaN values are ignored.
+   * @tparam T The element type, real numeric, logical or complex floating-point.
+   * @param array The array.
+   * @param dim The zero-based dimension, dimensions past the rank are singletons.
+   * @return The logical array of results, the reduced dimension has size 1.
+   */
+  template<typename T, std::enable_if_t<detail::isSummable<T>, int> = 0>
+  [[nodiscard]] LogicalArray any(TypedArrayCref<T> array, std::size_t dim)
+  {
+    return detail::reduceDim<bool>(array, dim, detail::LogicalReducer<T, false>{}, false,
+                                   [](bool value) noexcept { return value; });
+  }
+
+  /**
+   * @brief Tests if any element is nonzero, NaN values are ignored.
+   * @tparam T The element type, real numeric, logical or complex floating-point.
+   * @param array The array.
+   * @return True if any element is nonzero.
+   */
+  template<typename T, std::enable_if_t<detail::isSummable<T>, int> = 0>
+  [[nodiscard]] bool any(TypedArrayCref<T> array)
+  {
+    return detail::reduceAll(detail::LogicalReducer<T, false>{}, array.getData(), array.getSize());
+  }
+
+  /**
+   * @brief Tests if all elements along a dimension are nonzero, NaN values count as nonzero.
+   * @tparam T The element type, real numeric, logical or complex floating-point.
+   * @param array The array.
+   * @param dim The zero-based dimension, dimensions past the rank are singletons.
+   * @return The logical array of results, the reduced dimension has size 1.
+   */
+  template<typename T, std::enable_if_t<detail::isSummable<T>, int> = 0>
+  [[nodiscard]] LogicalArray all(TypedArrayCref<T> array, std::size_t dim)
+  {
+    return detail::reduceDim<bool>(array, dim, detail::LogicalReducer<T, true>{}, false,
+                                   [](bool value) noexcept { return value; });
+  }
+
+  /**
+   * @brief Tests if all elements are nonzero, NaN values count as nonzero.
+   * @tparam T The element type, real numeric, logical or complex floating-point.
+   * @param array The array.
+   * @return True if all elements are nonzero.
+   */
+  template<typename T, std::enable_if_t<detail::isSummable<T>, int> = 0>
+  [[nodiscard]] bool all(TypedArrayCref<T> array)
+  {
+    return detail::reduceAll(detail::LogicalReducer<T, true>{}, array.getData(), array.getSize());
+  }
+} // namespace matlabw::mx::reduce
+
+#endif /* MATLABW_MX_REDUCE_HPP */
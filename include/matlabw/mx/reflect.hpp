@@ -0,0 +1,469 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_REFLECT_HPP
+#define MATLABW_MX_REFLECT_HPP
+
+#include "detail/include.hpp"
+
+#include "CharArray.hpp"
+#include "FieldAccessor.hpp"
+#include "LogicalArray.hpp"
+#include "NumericArray.hpp"
+#include "StructArray.hpp"
+
+namespace matlabw::mx
+{
+  /**
+   * @brief Mapping of a data member to a structure array field.
+   * @tparam Class The class type.
+   * @tparam Member The data member type.
+   */
+  template<typename Class, typename Member>
+  struct StructField
+  {
+    const char*    name{};   ///< The field name.
+    Member Class::*member{}; ///< The data member.
+  };
+
+  /**
+   * @brief Field list of a C++ type mapped to structure arrays. Specialize it with MATLABW_MX_STRUCT_FIELDS, the
+   *        specialization provides a tuple of StructField objects named value.
+   * @tparam T The C++ type.
+   */
+  template<typename T>
+  struct StructFields;
+
+  /**
+   * @brief Checks if a type has a structure field list.
+   * @tparam T The type.
+   */
+  template<typename T>
+  concept StructMapped = requires { std::tuple_size<std::remove_cvref_t<decltype(StructFields<T>::value)>>::value; };
+
+namespace detail
+{
+  /**
+   * @brief Describes the expected value of a field, e.g. "real double scalar".
+   * @tparam T The element type.
+   * @param shape The expected shape.
+   * @return The description.
+   */
+  template<typename T>
+  [[nodiscard]] std::string describeStructField(std::string_view shape)
+  {
+    std::string description{};
+
+    if constexpr (isNumeric<T>)
+    {
+      description += isComplexNumeric<T> ? "complex " : "real ";
+    }
+
+    description += getClassName(TypeProperties<T>::classId);
+    description += ' ';
+    description += shape;
+
+    return description;
+  }
+
+  /**
+   * @brief Conversion of a data member to and from a field value.
+   * @tparam M The data member type.
+   */
+  template<typename M>
+  struct StructFieldTraits;
+
+  /**
+   * @brief Specialization of StructFieldTraits for numeric and logical scalars.
+   * @tparam M The data member type.
+   */
+  template<typename M>
+    requires (isNumeric<M> || std::is_same_v<M, bool>)
+  struct StructFieldTraits<M>
+  {
+    /**
+     * @brief Describes the expected field value.
+     * @return The description.
+     */
+    [[nodiscard]] static std::string describe()
+    {
+      return describeStructField<M>("scalar");
+    }
+
+    /**
+     * @brief Reads the field value.
+     * @param array The field value.
+     * @param value The data member.
+     * @return True on success, false on a type mismatch.
+     */
+    [[nodiscard]] static bool fromArray(ArrayCref array, M& value)
+    {
+      if (array.getClassId() != TypeProperties<M>::classId || array.isSparse() || array.getSize() != 1)
+      {
+        return false;
+      }
+
+      if constexpr (isNumeric<M>)
+      {
+        if (array.isComplex() != isComplexNumeric<M>)
+        {
+          return false;
+        }
+      }
+
+      value = *TypedArrayCref<M>{array, unchecked}.getData();
+
+      return true;
+    }
+
+    /**
+     * @brief Creates the field value.
+     * @param value The data member.
+     * @return The field value.
+     */
+    [[nodiscard]] static Array toArray(const M& value)
+    {
+      if constexpr (std::is_same_v<M, bool>)
+      {
+        return makeLogicalScalar(value);
+      }
+      else
+      {
+        return makeNumericScalar(value);
+      }
+    }
+  };
+
+  /**
+   * @brief Specialization of StructFieldTraits for numeric vectors, mapped to row vectors. Arrays of any shape are
+   *        accepted when reading.
+   * @tparam T The element type.
+   */
+  template<typename T>
+    requires isNumeric<T>
+  struct StructFieldTraits<std::vector<T>>
+  {
+    /**
+     * @brief Describes the expected field value.
+     * @return The description.
+     */
+    [[nodiscard]] static std::string describe()
+    {
+      return describeStructField<T>("array");
+    }
+
+    /**
+     * @brief Reads the field value.
+     * @param array The field value.
+     * @param value The data member.
+     * @return True on success, false on a type mismatch.
+     */
+    [[nodiscard]] static bool fromArray(ArrayCref array, std::vector<T>& value)
+    {
+      if (array.getClassId() != TypeProperties<T>::classId || array.isSparse()
+          || array.isComplex() != isComplexNumeric<T>)
+      {
+        return false;
+      }
+
+      const TypedArrayCref<T> typed{array, unchecked};
+
+      value.assign(typed.getData(), typed.getData() + typed.getSize());
+
+      return true;
+    }
+
+    /**
+     * @brief Creates the field value.
+     * @param value The data member.
+     * @return The field value.
+     */
+    [[nodiscard]] static Array toArray(const std::vector<T>& value)
+    {
+      NumericArray<T> array = makeUninitNumericArray<T>(1, value.size());
+
+      std::ranges::copy(value, array.getData());
+
+      return array;
+    }
+  };
+
+  /**
+   * @brief Specialization of StructFieldTraits for ASCII strings, mapped to char row vectors.
+   */
+  template<>
+  struct StructFieldTraits<std::string>
+  {
+    /**
+     * @brief Describes the expected field value.
+     * @return The description.
+     */
+    [[nodiscard]] static std::string describe()
+    {
+      return "ASCII char array";
+    }
+
+    /**
+     * @brief Reads the field value.
+     * @param array The field value.
+     * @param value The data member.
+     * @return True on success, false on a type mismatch.
+     */
+    [[nodiscard]] static bool fromArray(ArrayCref array, std::string& value)
+    {
+      if (array.getClassId() != ClassId::_char)
+      {
+        return false;
+      }
+
+      const TypedArrayCref<char16_t> chars{array, unchecked};
+
+      if (!std::ranges::all_of(chars, [](char16_t c) { return c < 128; }))
+      {
+        return false;
+      }
+
+      value.resize(chars.getSize());
+      std::ranges::transform(chars, value.begin(), [](char16_t c) { return static_cast<char>(c); });
+
+      return true;
+    }
+
+    /**
+     * @brief Creates the field value.
+     * @param value The data member.
+     * @return The field value.
+     */
+    [[nodiscard]] static Array toArray(const std::string& value)
+    {
+      return makeCharArray(std::string_view{value});
+    }
+  };
+
+  /**
+   * @brief Specialization of StructFieldTraits for UTF-16 strings, mapped to char row vectors.
+   */
+  template<>
+  struct StructFieldTraits<std::u16string>
+  {
+    /**
+     * @brief Describes the expected field value.
+     * @return The description.
+     */
+    [[nodiscard]] static std::string describe()
+    {
+      return "char array";
+    }
+
+    /**
+     * @brief Reads the field value.
+     * @param array The field value.
+     * @param value The data member.
+     * @return True on success, false on a type mismatch.
+     */
+    [[nodiscard]] static bool fromArray(ArrayCref array, std::u16string& value)
+    {
+      if (array.getClassId() != ClassId::_char)
+      {
+        return false;
+      }
+
+      const TypedArrayCref<char16_t> chars{array, unchecked};
+
+      value.assign(chars.getData(), chars.getSize());
+
+      return true;
+    }
+
+    /**
+     * @brief Creates the field value.
+     * @param value The data member.
+     * @return The field value.
+     */
+    [[nodiscard]] static Array toArray(const std::u16string& value)
+    {
+      CharArray array = makeCharArray({{1, value.size()}});
+
+      std::ranges::copy(value, array.getData());
+
+      return array;
+    }
+  };
+
+  /**
+   * @brief Gets the field names of a mapped type.
+   * @tparam T The mapped type.
+   * @return The field names in declaration order.
+   */
+  template<StructMapped T>
+  [[nodiscard]] constexpr auto getStructFieldNames() noexcept
+  {
+    return std::apply([](const auto&... fields)
+    {
+      return std::array<const char*, sizeof...(fields)>{fields.name...};
+    }, StructFields<T>::value);
+  }
+} // namespace detail
+
+  /**
+   * @brief Reads a structure array into C++ objects. The field indices are resolved once per array, each field value
+   *        is checked against the data member type and copied directly from the array data.
+   * @tparam T The C++ type, its fields must be listed by MATLABW_MX_STRUCT_FIELDS.
+   * @param array The structure array.
+   * @return One object per structure array element, in column-major order.
+   */
+  template<StructMapped T>
+  [[nodiscard]] std::vector<T> fromStruct(StructArrayCref array)
+  {
+    static constexpr auto fieldNames = detail::getStructFieldNames<T>();
+
+    const FieldAccessor<StructArrayCref> accessor{array, fieldNames};
+
+    for (std::size_t k{}; k < fieldNames.size(); ++k)
+    {
+      if (accessor.getFieldIndex(k) == FieldIndex::invalid)
+      {
+        throw Exception{"matlabw:mx:fromStruct:missingField", std::string{"missing field '"} + fieldNames[k] + "'"};
+      }
+    }
+
+    std::vector<T> values(array.getSize());
+
+    for (std::size_t i{}; i < values.size(); ++i)
+    {
+      [&]<std::size_t... ks>(std::index_sequence<ks...>)
+      {
+        ([&]
+        {
+          const auto& field = std::get<ks>(StructFields<T>::value);
+          auto&       value = values[i].*field.member;
+
+          using Traits = detail::StructFieldTraits<std::remove_cvref_t<decltype(value)>>;
+
+          const std::optional<ArrayCref> fieldValue = accessor.getField(i, ks);
+
+          if (!fieldValue.has_value() || !Traits::fromArray(*fieldValue, value))
+          {
+            throw Exception{"matlabw:mx:fromStruct:typeMismatch",
+                            std::string{"invalid field '"} + field.name + "' of element " + std::to_string(i + 1)
+                            + ", expected " + Traits::describe()};
+          }
+        }(), ...);
+      }(std::make_index_sequence<fieldNames.size()>{});
+    }
+
+    return values;
+  }
+
+  /**
+   * @brief Creates a 1xN structure array from C++ objects. The field indices are known from the field list, so no
+   *        field name is looked up.
+   * @tparam T The C++ type, its fields must be listed by MATLABW_MX_STRUCT_FIELDS.
+   * @param values The objects.
+   * @return The structure array.
+   */
+  template<StructMapped T>
+  [[nodiscard]] StructArray toStruct(std::span<const T> values)
+  {
+    static constexpr auto fieldNames = detail::getStructFieldNames<T>();
+
+    StructArray array = makeStructArray(1, values.size(), fieldNames);
+
+    FieldAccessor<StructArrayRef> accessor{array, fieldNames};
+
+    for (std::size_t i{}; i < values.size(); ++i)
+    {
+      [&]<std::size_t... ks>(std::index_sequence<ks...>)
+      {
+        ([&]
+        {
+          const auto& field = std::get<ks>(StructFields<T>::value);
+          const auto& value = values[i].*field.member;
+
+          using Traits = detail::StructFieldTraits<std::remove_cvref_t<decltype(value)>>;
+
+          accessor.setField(i, ks, Traits::toArray(value));
+        }(), ...);
+      }(std::make_index_sequence<fieldNames.size()>{});
+    }
+
+    return array;
+  }
+
+  /**
+   * @brief Creates a 1xN structure array from C++ objects.
+   * @tparam T The C++ type, its fields must be listed by MATLABW_MX_STRUCT_FIELDS.
+   * @param values The objects.
+   * @return The structure array.
+   */
+  template<StructMapped T>
+  [[nodiscard]] StructArray toStruct(const std::vector<T>& values)
+  {
+    return toStruct(std::span<const T>{values});
+  }
+} // namespace matlabw::mx
+
+/// @brief Expands to nothing, used to defer MATLABW_MX_DETAIL_FOR_EACH_AGAIN.
+#define MATLABW_MX_DETAIL_PARENS ()
+
+/// @brief Rescans the arguments 256 times, which bounds the number of fields.
+#define MATLABW_MX_DETAIL_EXPAND(...)  MATLABW_MX_DETAIL_EXPAND3(MATLABW_MX_DETAIL_EXPAND3(MATLABW_MX_DETAIL_EXPAND3(MATLABW_MX_DETAIL_EXPAND3(__VA_ARGS__))))
+#define MATLABW_MX_DETAIL_EXPAND3(...) MATLABW_MX_DETAIL_EXPAND2(MATLABW_MX_DETAIL_EXPAND2(MATLABW_MX_DETAIL_EXPAND2(MATLABW_MX_DETAIL_EXPAND2(__VA_ARGS__))))
+#define MATLABW_MX_DETAIL_EXPAND2(...) MATLABW_MX_DETAIL_EXPAND1(MATLABW_MX_DETAIL_EXPAND1(MATLABW_MX_DETAIL_EXPAND1(MATLABW_MX_DETAIL_EXPAND1(__VA_ARGS__))))
+#define MATLABW_MX_DETAIL_EXPAND1(...) __VA_ARGS__
+
+/// @brief Applies macro(type, member) to each member, separated by commas.
+#define MATLABW_MX_DETAIL_FOR_EACH(macro, type, ...) \
+  __VA_OPT__(MATLABW_MX_DETAIL_EXPAND(MATLABW_MX_DETAIL_FOR_EACH_HELPER(macro, type, __VA_ARGS__)))
+#define MATLABW_MX_DETAIL_FOR_EACH_HELPER(macro, type, member, ...) \
+  macro(type, member) __VA_OPT__(, MATLABW_MX_DETAIL_FOR_EACH_AGAIN MATLABW_MX_DETAIL_PARENS (macro, type, __VA_ARGS__))
+#define MATLABW_MX_DETAIL_FOR_EACH_AGAIN() MATLABW_MX_DETAIL_FOR_EACH_HELPER
+
+/// @brief Creates the StructField of a data member named like the field.
+#define MATLABW_MX_DETAIL_STRUCT_FIELD(type, member) ::matlabw::mx::StructField{#member, &type::member}
+
+/**
+ * @brief Lists the data members of a C++ type mapped to structure array fields of the same names, e.g.
+ * @code
+ *   struct Entry
+ *   {
+ *     std::string name;
+ *     double      phone;
+ *   };
+ *
+ *   MATLABW_MX_STRUCT_FIELDS(Entry, name, phone)
+ * @endcode
+ * Must be used in the global namespace. Supported data member types are numeric and logical scalars, std::vector of a
+ * numeric type, std::string (ASCII) and std::u16string.
+ */
+#define MATLABW_MX_STRUCT_FIELDS(type, ...)                                                    \
+  template<>                                                                                   \
+  struct matlabw::mx::StructFields<type>                                                       \
+  {                                                                                            \
+    static constexpr std::tuple value{                                                         \
+      MATLABW_MX_DETAIL_FOR_EACH(MATLABW_MX_DETAIL_STRUCT_FIELD, type, __VA_ARGS__)            \
+    };                                                                                         \
+  };
+
+#endif /* MATLABW_MX_REFLECT_HPP */
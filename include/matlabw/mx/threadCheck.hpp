@@ -0,0 +1,102 @@
+/*
+  This file is part of matlab-cpp-wrapper library.
+
+  Copyright (c) 2024 David Bayer
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#ifndef MATLABW_MX_THREAD_CHECK_HPP
+#define MATLABW_MX_THREAD_CHECK_HPP
+
+#include "detail/include.hpp"
+
+#include "Exception.hpp"
+
+namespace matlabw::mx
+{
+  namespace detail
+  {
+    /**
+     * @brief Gets the flag marking the MATLAB thread.
+     * @return Reference to the thread-local flag.
+     */
+    [[nodiscard]] inline bool& getMatlabThreadFlag() noexcept
+    {
+      thread_local bool isMatlabThread{};
+
+      return isMatlabThread;
+    }
+
+    /**
+     * @brief Gets the flag telling whether the MATLAB thread has been registered.
+     * @return Reference to the flag.
+     */
+    [[nodiscard]] inline std::atomic<bool>& getMatlabThreadRegistered() noexcept
+    {
+      static std::atomic<bool> registered{};
+
+      return registered;
+    }
+
+    /**
+     * @brief Throws the exception reporting a call from a thread other than the MATLAB thread. Kept out of the
+     *        checking function so that the check itself stays small enough to be inlined.
+     * @param id Function ID
+     */
+    [[noreturn]] inline void throwWrongThread(const char* id)
+    {
+      throw Exception{id, "MATLAB API called from a thread other than the one that entered mexFunction"};
+    }
+  } // namespace detail
+
+  /// @brief Registers the calling thread as the MATLAB thread. Called on entry of mexFunction.
+  inline void registerMatlabThread() noexcept
+  {
+    detail::getMatlabThreadFlag() = true;
+    detail::getMatlabThreadRegistered().store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Checks if the calling thread may call into the MATLAB API.
+   * @return True if the calling thread is the MATLAB thread or no MATLAB thread has been registered.
+   */
+  [[nodiscard]] inline bool isMatlabThread() noexcept
+  {
+    return detail::getMatlabThreadFlag() || !detail::getMatlabThreadRegistered().load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Checks that the calling thread may call into the MATLAB API if MATLABW_THREAD_CHECK is defined, does
+   *        nothing otherwise. The check costs a thread-local load and a predictable branch, so it can stay enabled
+   *        in optimized builds.
+   * @param id Function ID
+   */
+  inline void checkThread([[maybe_unused]] const char* id)
+  {
+#ifdef MATLABW_THREAD_CHECK
+    if (!isMatlabThread()) [[unlikely]]
+    {
+      detail::throwWrongThread(id);
+    }
+#endif
+  }
+} // namespace matlabw::mx
+
+#endif /* MATLABW_MX_THREAD_CHECK_HPP */
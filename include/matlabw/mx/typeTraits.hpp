@@ -123,6 +123,22 @@ namespace matlabw::mx
   template<typename T>
   inline constexpr bool isRealNumeric = IsRealNumeric<T>::value;
 
+  /**
+   * @brief IsSparseValue trait. Sparse arrays may store double, complex double or logical values.
+   * @tparam T Type.
+   */
+  template<typename T>
+  struct IsSparseValue : std::bool_constant<std::is_same_v<std::remove_cv_t<T>, double>
+                                            || std::is_same_v<std::remove_cv_t<T>, std::complex<double>>
+                                            || std::is_same_v<std::remove_cv_t<T>, bool>> {};
+
+  /**
+   * @brief isSparseValue value.
+   * @tparam T Type.
+   */
+  template<typename T>
+  inline constexpr bool isSparseValue = IsSparseValue<T>::value;
+
   /**
    * @brief Class ID constant.
    * @tparam _classId Class ID.